@@ -60,7 +60,8 @@
  * operations and mathematical functions. It configures precision settings,
  * creates complex numbers, and performs various operations such as addition,
  * subtraction, multiplication, division, magnitude, argument, conjugate,
- * and exponential.
+ * and exponential. Define `ALMOST_NO_MAIN` to include this file without
+ * it (see bench/almost_bench.c).
  */
 #include <stdio.h>
 
@@ -217,6 +218,7 @@ void complex_print(complex_t z) {
 }
 
 // Example usage
+#ifndef ALMOST_NO_MAIN
 int main() {
     // Configure precision (terms, error threshold, pi value)
     setup(15, 1e-12, 3.14159265358979323846);
@@ -238,4 +240,5 @@ int main() {
     printf("exp(a) = "); complex_print(complex_exp(a));
     
     return 0;
-}
\ No newline at end of file
+}
+#endif
@@ -0,0 +1,116 @@
+/*
+ * almost.c Benchmarks - scalar series kernels and complex operations
+ *
+ * Every case maps one kernel over a fixed table of inputs, so times are
+ * ns per call. Precision is the demo configuration: setup(15, 1e-12, π).
+ *
+ * Build: make -C bench
+ * Usage: ./almost_bench [options]
+ */
+
+#include "bench.h"
+
+#define ALMOST_NO_MAIN
+#include "../almost.c"
+
+#define INPUTS 4096
+
+static double scalars[INPUTS];      // [-2π, 2π]
+static double positives[INPUTS];    // (0, 100]
+static complex_t lefts[INPUTS];
+static complex_t rights[INPUTS];    // Never zero, for complex_div
+
+static void init_inputs(void) {
+    uint64_t seed = 0x2545f4914f6cdd1dULL;
+    for (int i = 0; i < INPUTS; i++) {
+        double u[5];
+        for (int k = 0; k < 5; k++) {
+            seed ^= seed << 13;
+            seed ^= seed >> 7;
+            seed ^= seed << 17;
+            u[k] = (double)(seed >> 11) / (double)(1ULL << 53);
+        }
+        scalars[i] = (u[0] * 2.0 - 1.0) * 2.0 * config.pi;
+        positives[i] = 100.0 * (1.0 - u[1]);
+        lefts[i] = complex_new(u[2] * 8.0 - 4.0, u[3] * 8.0 - 4.0);
+        rights[i] = complex_new(0.5 + u[4] * 3.0, u[2] * 6.0 - 3.0);
+    }
+}
+
+// ============================================================================
+// SCALAR KERNELS
+// ============================================================================
+
+#define SCALAR_KERNEL(name, expression)                    \
+    static void run_##name(void* state) {                  \
+        (void)state;                                       \
+        double sum = 0;                                    \
+        for (int i = 0; i < INPUTS; i++) sum += expression; \
+        bench_sink = sum;                                  \
+    }
+
+SCALAR_KERNEL(abs_val, abs_val(scalars[i]))
+SCALAR_KERNEL(sqrt_val, sqrt_val(positives[i]))
+SCALAR_KERNEL(sin_val, sin_val(scalars[i]))
+SCALAR_KERNEL(cos_val, cos_val(scalars[i]))
+SCALAR_KERNEL(atan_val, atan_val(scalars[i]))
+SCALAR_KERNEL(atan2_val, atan2_val(lefts[i].im, lefts[i].re))
+SCALAR_KERNEL(exp_val, exp_val(scalars[i]))
+
+// ============================================================================
+// COMPLEX KERNELS
+// ============================================================================
+
+#define COMPLEX_KERNEL(name, expression)                   \
+    static void run_##name(void* state) {                  \
+        (void)state;                                       \
+        complex_t sum = { 0, 0 };                          \
+        for (int i = 0; i < INPUTS; i++) {                 \
+            complex_t z = expression;                      \
+            sum.re += z.re;                                \
+            sum.im += z.im;                                \
+        }                                                  \
+        bench_sink = sum.re + sum.im;                      \
+    }
+
+COMPLEX_KERNEL(complex_add, complex_add(lefts[i], rights[i]))
+COMPLEX_KERNEL(complex_sub, complex_sub(lefts[i], rights[i]))
+COMPLEX_KERNEL(complex_mul, complex_mul(lefts[i], rights[i]))
+COMPLEX_KERNEL(complex_div, complex_div(lefts[i], rights[i]))
+COMPLEX_KERNEL(complex_conj, complex_conj(lefts[i]))
+COMPLEX_KERNEL(complex_exp, complex_exp(lefts[i]))
+SCALAR_KERNEL(complex_abs, complex_abs(lefts[i]))
+SCALAR_KERNEL(complex_arg, complex_arg(lefts[i]))
+
+int main(int argc, char** argv) {
+    BenchSuite suite;
+    if (bench_init(&suite, "almost", argc, argv, NULL) < 0) return 2;
+
+    setup(15, 1e-12, 3.14159265358979323846);
+    init_inputs();
+
+    const BenchCase cases[] = {
+        { "scalar/abs_val", NULL, run_abs_val, NULL, INPUTS, 0 },
+        { "scalar/sqrt_val", NULL, run_sqrt_val, NULL, INPUTS, 0 },
+        { "scalar/sin_val", NULL, run_sin_val, NULL, INPUTS, 0 },
+        { "scalar/cos_val", NULL, run_cos_val, NULL, INPUTS, 0 },
+        { "scalar/atan_val", NULL, run_atan_val, NULL, INPUTS, 0 },
+        { "scalar/atan2_val", NULL, run_atan2_val, NULL, INPUTS, 0 },
+        { "scalar/exp_val", NULL, run_exp_val, NULL, INPUTS, 0 },
+        { "complex/add", NULL, run_complex_add, NULL, INPUTS, 0 },
+        { "complex/sub", NULL, run_complex_sub, NULL, INPUTS, 0 },
+        { "complex/mul", NULL, run_complex_mul, NULL, INPUTS, 0 },
+        { "complex/div", NULL, run_complex_div, NULL, INPUTS, 0 },
+        { "complex/abs", NULL, run_complex_abs, NULL, INPUTS, 0 },
+        { "complex/arg", NULL, run_complex_arg, NULL, INPUTS, 0 },
+        { "complex/conj", NULL, run_complex_conj, NULL, INPUTS, 0 },
+        { "complex/exp", NULL, run_complex_exp, NULL, INPUTS, 0 },
+    };
+
+    for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+        bench_run(&suite, &cases[c]);
+    }
+
+    bench_finish(&suite);
+    return 0;
+}
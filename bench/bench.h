@@ -0,0 +1,374 @@
+/*
+ * bench.h - Minimal benchmark harness shared by the bench binaries
+ *
+ * Each case is warmed up, then timed for a number of repetitions; the
+ * report gives min, median, p90, p99, max and mean per work item. Cases
+ * without a per-sample prepare step run their body in a calibrated inner
+ * loop so one sample lasts at least --min-ms.
+ *
+ * With -p the cycles, cache-miss and branch-miss hardware counters are
+ * read around every sample through perf_event_open(2); when the kernel
+ * refuses (perf_event_paranoid, containers) the run continues without
+ * them. -j writes all results as JSON, stamped with the source revision
+ * (BENCH_REVISION, set by bench/Makefile) so runs from different commits
+ * can be compared with bench_compare.
+ *
+ * Common options:
+ *   -r N    measured repetitions (default 15)
+ *   -w N    warm-up repetitions (default 3)
+ *   -m MS   minimum sample duration in ms for calibrated cases (default 2)
+ *   -f STR  only run cases whose name contains STR
+ *   -p      collect hardware counters
+ *   -j FILE write JSON results
+ */
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <time.h>
+#include <unistd.h>
+#include <getopt.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+#ifndef BENCH_REVISION
+#define BENCH_REVISION "unknown"
+#endif
+
+#define BENCH_COUNTERS 3
+
+typedef struct {
+    const char* name;
+    void (*prepare)(void* state);  // Untimed, before every sample (optional)
+    void (*run)(void* state);      // Timed body
+    void* state;
+    size_t items;                  // Work items per run, for ns/item
+    size_t bytes;                  // Bytes per run, for MB/s (optional)
+} BenchCase;
+
+typedef struct {
+    char* name;
+    size_t items;
+    size_t bytes;
+    size_t inner;
+    int samples;
+    double min, median, p90, p99, max, mean;  // ns per item
+    bool has_counters;
+    double counters[BENCH_COUNTERS];          // Median per item
+    const char* extra_name;                   // Case-specific figure (optional)
+    double extra;
+} BenchResult;
+
+typedef struct {
+    const char* suite;
+    int repetitions;
+    int warmup;
+    double min_sample_ns;
+    const char* filter;
+    const char* json_path;
+    bool perf;
+    int perf_fds[BENCH_COUNTERS];
+    BenchResult* results;
+    size_t result_count;
+    size_t result_capacity;
+} BenchSuite;
+
+static const char* const bench_counter_names[BENCH_COUNTERS] = {
+    "cycles", "cache_misses", "branch_misses"
+};
+
+static volatile double bench_sink;  // Defeats dead-code elimination
+
+static double bench_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// ============================================================================
+// HARDWARE COUNTERS (perf_event_open)
+// ============================================================================
+
+static int bench_perf_open(uint64_t config, int group) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = config;
+    attr.disabled = group < 0;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP;
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, group, 0);
+}
+
+static void bench_perf_start(BenchSuite* suite) {
+    static const uint64_t configs[BENCH_COUNTERS] = {
+        PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES
+    };
+
+    for (int i = 0; i < BENCH_COUNTERS; i++) {
+        suite->perf_fds[i] = bench_perf_open(configs[i], i ? suite->perf_fds[0] : -1);
+        if (suite->perf_fds[i] < 0) {
+            fprintf(stderr, "bench: hardware counters unavailable, continuing without -p\n");
+            for (int j = 0; j < i; j++) close(suite->perf_fds[j]);
+            suite->perf = false;
+            return;
+        }
+    }
+}
+
+static void bench_perf_enable(BenchSuite* suite) {
+    ioctl(suite->perf_fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(suite->perf_fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+}
+
+static void bench_perf_disable(BenchSuite* suite, double* values) {
+    uint64_t buffer[1 + BENCH_COUNTERS];
+
+    ioctl(suite->perf_fds[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+    if (read(suite->perf_fds[0], buffer, sizeof(buffer)) != (ssize_t)sizeof(buffer)) {
+        memset(buffer, 0, sizeof(buffer));
+    }
+    for (int i = 0; i < BENCH_COUNTERS; i++) values[i] = (double)buffer[1 + i];
+}
+
+// ============================================================================
+// SUITE
+// ============================================================================
+
+static void bench_usage(const char* program, const char* extra) {
+    fprintf(stderr,
+        "Usage: %s [-r reps] [-w warmup] [-m min_ms] [-f filter] [-p] [-j out.json]%s\n",
+        program, extra ? extra : "");
+}
+
+// Parse the common options; returns the index of the first positional
+// argument, or -1 on a usage error.
+static int bench_init(BenchSuite* suite, const char* name, int argc, char** argv,
+                      const char* extra_usage) {
+    int opt;
+
+    memset(suite, 0, sizeof(*suite));
+    suite->suite = name;
+    suite->repetitions = 15;
+    suite->warmup = 3;
+    suite->min_sample_ns = 2e6;
+
+    while ((opt = getopt(argc, argv, "r:w:m:f:pj:h")) != -1) {
+        switch (opt) {
+            case 'r': suite->repetitions = atoi(optarg); break;
+            case 'w': suite->warmup = atoi(optarg); break;
+            case 'm': suite->min_sample_ns = atof(optarg) * 1e6; break;
+            case 'f': suite->filter = optarg; break;
+            case 'p': suite->perf = true; break;
+            case 'j': suite->json_path = optarg; break;
+            default:
+                bench_usage(argv[0], extra_usage);
+                return -1;
+        }
+    }
+    if (suite->repetitions < 1) suite->repetitions = 1;
+    if (suite->warmup < 0) suite->warmup = 0;
+    if (suite->perf) bench_perf_start(suite);
+
+    printf("=== %s benchmarks (revision %s) ===\n", name, BENCH_REVISION);
+    printf("%-40s %13s %13s %13s %13s %9s\n",
+           "case", "min", "median", "p90", "p99", "MB/s");
+    return optind;
+}
+
+static int bench_compare_doubles(const void* a, const void* b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+// Nearest-rank percentile of a sorted sample
+static double bench_percentile(const double* sorted, int count, double percent) {
+    int rank = (int)(percent / 100.0 * count + 0.999999);
+    if (rank < 1) rank = 1;
+    if (rank > count) rank = count;
+    return sorted[rank - 1];
+}
+
+static double bench_sample(BenchSuite* suite, const BenchCase* bench, size_t inner,
+                           double* counters) {
+    if (bench->prepare) bench->prepare(bench->state);
+    if (suite->perf) bench_perf_enable(suite);
+
+    double start = bench_now_ns();
+    for (size_t i = 0; i < inner; i++) bench->run(bench->state);
+    double elapsed = bench_now_ns() - start;
+
+    if (suite->perf) bench_perf_disable(suite, counters);
+    return elapsed;
+}
+
+// Returns the recorded result, or NULL when the case was filtered out
+static BenchResult* bench_run(BenchSuite* suite, const BenchCase* bench) {
+    if (suite->filter && !strstr(bench->name, suite->filter)) return NULL;
+
+    int repetitions = suite->repetitions;
+    double* samples = malloc(repetitions * sizeof(double));
+    double* counters = calloc((size_t)repetitions * BENCH_COUNTERS, sizeof(double));
+    double scratch[BENCH_COUNTERS];
+    size_t inner = 1;
+
+    // Warm-up; cases without a prepare step also calibrate the inner loop
+    for (int w = 0; w < suite->warmup || (!bench->prepare && w == 0); w++) {
+        double elapsed = bench_sample(suite, bench, inner, scratch);
+        while (!bench->prepare && elapsed * 2 < suite->min_sample_ns && inner < (1u << 30)) {
+            inner *= 2;
+            elapsed = bench_sample(suite, bench, inner, scratch);
+        }
+    }
+
+    size_t per_sample = inner * (bench->items ? bench->items : 1);
+    for (int r = 0; r < repetitions; r++) {
+        samples[r] = bench_sample(suite, bench, inner, scratch) / per_sample;
+        for (int c = 0; c < BENCH_COUNTERS; c++) {
+            counters[c * repetitions + r] = scratch[c] / per_sample;
+        }
+    }
+
+    if (suite->result_count >= suite->result_capacity) {
+        suite->result_capacity = suite->result_capacity ? suite->result_capacity * 2 : 32;
+        suite->results = realloc(suite->results, suite->result_capacity * sizeof(BenchResult));
+    }
+    BenchResult* result = &suite->results[suite->result_count++];
+    memset(result, 0, sizeof(*result));
+    result->name = strdup(bench->name);
+    result->items = bench->items;
+    result->bytes = bench->bytes;
+    result->inner = inner;
+    result->samples = repetitions;
+
+    double sum = 0;
+    for (int r = 0; r < repetitions; r++) sum += samples[r];
+    qsort(samples, repetitions, sizeof(double), bench_compare_doubles);
+    result->min = samples[0];
+    result->median = bench_percentile(samples, repetitions, 50);
+    result->p90 = bench_percentile(samples, repetitions, 90);
+    result->p99 = bench_percentile(samples, repetitions, 99);
+    result->max = samples[repetitions - 1];
+    result->mean = sum / repetitions;
+
+    if (suite->perf) {
+        result->has_counters = true;
+        for (int c = 0; c < BENCH_COUNTERS; c++) {
+            double* column = counters + c * repetitions;
+            qsort(column, repetitions, sizeof(double), bench_compare_doubles);
+            result->counters[c] = bench_percentile(column, repetitions, 50);
+        }
+    }
+
+    // Times are ns per item; MB/s from the median when the case has a size
+    double items = bench->items ? bench->items : 1;
+    char throughput[32] = "-";
+    if (bench->bytes) {
+        snprintf(throughput, sizeof(throughput), "%.1f",
+                 bench->bytes / (result->median * items) * 1e9 / (1024.0 * 1024.0));
+    }
+    printf("%-40s %13.2f %13.2f %13.2f %13.2f %9s", bench->name,
+           result->min, result->median, result->p90, result->p99, throughput);
+    if (result->has_counters) {
+        printf("  cyc %.1f  cmiss %.3f  bmiss %.3f",
+               result->counters[0], result->counters[1], result->counters[2]);
+    }
+    printf("\n");
+
+    free(samples);
+    free(counters);
+    return result;
+}
+
+// Attach a case-specific figure to a result; it is printed and written to JSON
+static void bench_annotate(BenchResult* result, const char* name, double value) {
+    if (!result) return;
+    result->extra_name = name;
+    result->extra = value;
+    printf("%-40s %s = %.6g\n", "", name, value);
+}
+
+static void bench_write_string(FILE* out, const char* str) {
+    fputc('"', out);
+    for (const unsigned char* p = (const unsigned char*)str; *p; p++) {
+        switch (*p) {
+            case '"': fputs("\\\"", out); break;
+            case '\\': fputs("\\\\", out); break;
+            case '\n': fputs("\\n", out); break;
+            case '\r': fputs("\\r", out); break;
+            case '\t': fputs("\\t", out); break;
+            default:
+                if (*p < 0x20) fprintf(out, "\\u%04x", *p);
+                else fputc(*p, out);
+        }
+    }
+    fputc('"', out);
+}
+
+static void bench_write_json(const BenchSuite* suite) {
+    FILE* out = fopen(suite->json_path, "w");
+    if (!out) {
+        perror(suite->json_path);
+        return;
+    }
+
+    fprintf(out, "{\"suite\": ");
+    bench_write_string(out, suite->suite);
+    fprintf(out, ", \"revision\": ");
+    bench_write_string(out, BENCH_REVISION);
+    fprintf(out, ", \"timestamp\": %ld, \"compiler\": ", (long)time(NULL));
+#if defined(__clang__)
+    bench_write_string(out, "clang " __clang_version__);
+#elif defined(__GNUC__)
+    bench_write_string(out, "gcc " __VERSION__);
+#else
+    bench_write_string(out, "unknown");
+#endif
+    fprintf(out, ", ");
+    fprintf(out, "\"repetitions\": %d, \"warmup\": %d, \"unit\": \"ns/item\", \"results\": [",
+            suite->repetitions, suite->warmup);
+
+    for (size_t i = 0; i < suite->result_count; i++) {
+        const BenchResult* r = &suite->results[i];
+        fprintf(out, "%s\n  {\"name\": ", i ? "," : "");
+        bench_write_string(out, r->name);
+        fprintf(out, ", \"items\": %zu, \"bytes\": %zu, \"inner\": %zu, "
+                "\"samples\": %d, \"min\": %.6g, \"median\": %.6g, \"p90\": %.6g, "
+                "\"p99\": %.6g, \"max\": %.6g, \"mean\": %.6g",
+                r->items, r->bytes, r->inner, r->samples,
+                r->min, r->median, r->p90, r->p99, r->max, r->mean);
+        if (r->extra_name) {
+            fprintf(out, ", ");
+            bench_write_string(out, r->extra_name);
+            fprintf(out, ": %.6g", r->extra);
+        }
+        if (r->has_counters) {
+            for (int c = 0; c < BENCH_COUNTERS; c++) {
+                fprintf(out, ", \"%s\": %.6g", bench_counter_names[c], r->counters[c]);
+            }
+        }
+        fprintf(out, "}");
+    }
+    fprintf(out, "\n]}\n");
+    fclose(out);
+}
+
+static void bench_finish(BenchSuite* suite) {
+    if (suite->json_path) bench_write_json(suite);
+    if (suite->perf) {
+        for (int i = 0; i < BENCH_COUNTERS; i++) close(suite->perf_fds[i]);
+    }
+    for (size_t i = 0; i < suite->result_count; i++) free(suite->results[i].name);
+    free(suite->results);
+}
+
+#endif
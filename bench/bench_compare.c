@@ -0,0 +1,109 @@
+/*
+ * Benchmark Comparison - median ratios between two result files
+ *
+ * Reads JSON written by any bench binary's -j option (parsed with
+ * omega_parse) and prints, per case present in both runs, the baseline
+ * and candidate medians and their ratio. Cases slower than the threshold
+ * are flagged and make the exit status 1.
+ *
+ * Build: make -C bench
+ * Usage: ./bench_compare [-t percent] baseline.json candidate.json
+ */
+
+#define OMEGAJSON_NO_MAIN
+#include "../omegajson.c"
+
+#include <unistd.h>
+
+static OmegaValue* load_results(const char* path) {
+    FILE* in = fopen(path, "rb");
+    if (!in) {
+        perror(path);
+        return NULL;
+    }
+
+    OmegaBuffer buffer = {0};
+    char chunk[65536];
+    size_t n;
+    while ((n = fread(chunk, 1, sizeof(chunk), in)) > 0) buffer_append(&buffer, chunk, n);
+    fclose(in);
+
+    OmegaValue* results = buffer.data ? omega_parse(buffer.data, buffer.length) : NULL;
+    free(buffer.data);
+    if (!results || !omega_pointer_get(results, "/results")) {
+        fprintf(stderr, "%s: not a benchmark result file\n", path);
+        omega_destroy(results);
+        return NULL;
+    }
+    return results;
+}
+
+static const char* result_string(OmegaValue* results, const char* pointer) {
+    OmegaValue* value = omega_pointer_get(results, pointer);
+    return value && value->type == OMEGA_STRING ? value->data.string : "?";
+}
+
+static double result_median(OmegaValue* entry) {
+    OmegaValue* median = omega_object_get(entry, "median");
+    return median && median->type == OMEGA_NUMBER ? median->data.number : 0;
+}
+
+int main(int argc, char** argv) {
+    double threshold = 5.0;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "t:")) != -1) {
+        if (opt == 't') threshold = atof(optarg);
+        else break;
+    }
+    if (argc - optind != 2) {
+        fprintf(stderr, "Usage: %s [-t percent] baseline.json candidate.json\n", argv[0]);
+        return 2;
+    }
+
+    OmegaValue* baseline = load_results(argv[optind]);
+    OmegaValue* candidate = load_results(argv[optind + 1]);
+    if (!baseline || !candidate) {
+        omega_destroy(baseline);
+        omega_destroy(candidate);
+        return 2;
+    }
+
+    printf("=== %s: %s -> %s ===\n", result_string(baseline, "/suite"),
+           result_string(baseline, "/revision"), result_string(candidate, "/revision"));
+    printf("%-40s %13s %13s %8s\n", "case", "baseline", "candidate", "ratio");
+
+    OmegaValue* before = omega_pointer_get(baseline, "/results");
+    OmegaValue* after = omega_pointer_get(candidate, "/results");
+    size_t regressions = 0;
+
+    for (size_t i = 0; i < after->data.array.count; i++) {
+        OmegaValue* entry = after->data.array.elements[i];
+        OmegaValue* name = omega_object_get(entry, "name");
+        if (!name || name->type != OMEGA_STRING) continue;
+
+        OmegaValue* match = NULL;
+        for (size_t j = 0; j < before->data.array.count && !match; j++) {
+            OmegaValue* other = omega_object_get(before->data.array.elements[j], "name");
+            if (other && other->type == OMEGA_STRING &&
+                strcmp(other->data.string, name->data.string) == 0) {
+                match = before->data.array.elements[j];
+            }
+        }
+        if (!match) continue;
+
+        double old_median = result_median(match);
+        double new_median = result_median(entry);
+        double ratio = old_median > 0 ? new_median / old_median : 0;
+        bool regressed = ratio > 1.0 + threshold / 100.0;
+        if (regressed) regressions++;
+
+        printf("%-40s %13.2f %13.2f %7.3fx%s\n", name->data.string,
+               old_median, new_median, ratio, regressed ? "  REGRESSION" : "");
+    }
+
+    printf("\n%zu case(s) slower by more than %.1f%%\n", regressions, threshold);
+    omega_destroy(baseline);
+    omega_destroy(candidate);
+    return regressions ? 1 : 0;
+}
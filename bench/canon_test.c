@@ -0,0 +1,156 @@
+/*
+ * Canonicalization Regression Test - randomized edits vs. fresh ω*
+ *
+ * Builds random trees, applies random appends and sets (new keys and
+ * replacements) at random depths, and after every edit checks that
+ * re-canonicalizing the edited tree gives the same canonical bytes and
+ * hash as parsing its compact JSON into a new tree with a new cache.
+ * This covers dirty-spine invalidation, the memo's epoch check, hashes
+ * trusted across caches, and cache resets (one cache is capped at
+ * SMALL_CACHE_NODES so it resets constantly).
+ *
+ * Build: make -C bench
+ * Usage: ./canon_test [trees]
+ */
+
+#define OMEGAJSON_NO_MAIN
+#include "../omegajson.c"
+
+#define EDITS_PER_TREE 20
+#define SMALL_CACHE_NODES 64
+
+static uint64_t seed = 0x2545f4914f6cdd1dULL;
+
+static unsigned next_random(unsigned bound) {
+    seed ^= seed << 13;
+    seed ^= seed >> 7;
+    seed ^= seed << 17;
+    return (unsigned)((seed >> 11) % bound);
+}
+
+// Small key and value alphabets, so replacements and shared subtrees are common
+static OmegaValue* random_value(int depth) {
+    char key[8];
+    int kind = next_random(depth > 3 ? 3 : 6);
+
+    switch (kind) {
+        case 0:
+            return omega_create_number((int)next_random(7) - 3.0 + (next_random(2) ? 0.5 : 0));
+        case 1:
+            return omega_create_string(next_random(2) ? "a\"b" : "c");
+        case 2:
+            return omega_create_bool(next_random(2));
+        case 3: {
+            OmegaValue* array = omega_create_array();
+            for (unsigned i = next_random(6); i > 0; i--) {
+                omega_array_append(array, random_value(depth + 1));
+            }
+            return array;
+        }
+        default: {
+            OmegaValue* object = omega_create_object();
+            for (unsigned i = next_random(6); i > 0; i--) {
+                snprintf(key, sizeof(key), "k%u", next_random(20));
+                omega_object_set(object, key, random_value(depth + 1));
+            }
+            return object;
+        }
+    }
+}
+
+// A random container on a random path from the root
+static OmegaValue* random_container(OmegaValue* omega) {
+    for (;;) {
+        size_t count = omega->type == OMEGA_ARRAY ? omega->data.array.count
+                     : omega->data.object->count;
+        if (count == 0 || next_random(3) == 0) return omega;
+
+        size_t i = next_random(count);
+        OmegaValue* child = omega->type == OMEGA_ARRAY ? omega->data.array.elements[i]
+                          : omega->data.object->entries[i].value;
+        if (child->type != OMEGA_ARRAY && child->type != OMEGA_OBJECT) return omega;
+        omega = child;
+    }
+}
+
+static void random_edit(OmegaValue* root) {
+    OmegaValue* container = random_container(root);
+    if (container->type == OMEGA_ARRAY) {
+        omega_array_append(container, random_value(3));
+    } else {
+        char key[8];
+        snprintf(key, sizeof(key), "k%u", next_random(20));
+        omega_object_set(container, key, random_value(3));
+    }
+}
+
+// Compare the memoized ω* against one computed from scratch
+static bool check_canonical(OmegaValue* root, OmegaCanonCache* cache, const char* label) {
+    OmegaBuffer text = {0};
+    omega_serialize_compact(root, &text);
+    OmegaValue* fresh = omega_parse(text.data, text.length);
+    OmegaCanonCache* fresh_cache = omega_canon_cache_create();
+
+    size_t length, expected_length;
+    char* bytes = omega_serialize_canonical(root, cache, &length);
+    char* expected = omega_serialize_canonical(fresh, fresh_cache, &expected_length);
+    uint64_t hash = omega_canonicalize(root, cache)->hash;
+    uint64_t expected_hash = omega_canonicalize(fresh, fresh_cache)->hash;
+
+    bool ok = length == expected_length && memcmp(bytes, expected, length) == 0 &&
+              hash == expected_hash;
+    if (!ok) {
+        fprintf(stderr, "%s mismatch\n  memoized: %s (%016llx)\n  fresh:    %s (%016llx)\n",
+                label, bytes, (unsigned long long)hash,
+                expected, (unsigned long long)expected_hash);
+    }
+
+    free(bytes);
+    free(expected);
+    free(text.data);
+    omega_destroy(fresh);
+    omega_canon_cache_destroy(fresh_cache);
+    return ok;
+}
+
+int main(int argc, char** argv) {
+    int trees = argc > 1 ? atoi(argv[1]) : 300;
+
+    // One long-lived cache per configuration, shared by every tree and
+    // edit; the other cache also sees every tree, so hashes cross caches
+    OmegaCanonCache* large = omega_canon_cache_create();
+    OmegaCanonCache* small = omega_canon_cache_create();
+    small->max_nodes = SMALL_CACHE_NODES;
+    size_t failures = 0;
+
+    for (int t = 0; t < trees; t++) {
+        OmegaValue* root = omega_create_array();
+        for (int i = 0; i < 4; i++) omega_array_append(root, random_value(1));
+
+        for (int e = 0; e < EDITS_PER_TREE; e++) {
+            random_edit(root);
+            if (!check_canonical(root, large, "default cache")) failures++;
+            if (!check_canonical(root, small, "small cache")) failures++;
+
+            // Representatives belong to one cache: a memo from the other
+            // cache (or from before a reset) must not be returned
+            if (omega_canonicalize(root, large) == omega_canonicalize(root, small)) {
+                fprintf(stderr, "representative shared across caches\n");
+                failures++;
+            }
+        }
+        omega_destroy(root);
+    }
+
+    printf("%d trees x %d edits: %zu failure(s); memo hits %zu (default) %zu (small); "
+           "small cache resets %zu\n", trees, EDITS_PER_TREE, failures,
+           large->memo_hits, small->memo_hits, small->resets);
+
+    // A run that never took the memo or reset paths tested nothing new
+    bool exercised = trees == 0 || (large->memo_hits > 0 && small->resets > 0);
+    if (!exercised) fprintf(stderr, "memo or reset path not exercised\n");
+
+    omega_canon_cache_destroy(large);
+    omega_canon_cache_destroy(small);
+    return failures == 0 && exercised ? 0 : 1;
+}
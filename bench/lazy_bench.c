@@ -0,0 +1,130 @@
+/*
+ * Lazy Access Benchmark - single-field reads from large OmegaJSON documents
+ *
+ * Compares parse-on-touch (structural index + one materialized path)
+ * against full materialization of every OmegaValue node. Times are per
+ * document (or per access for the warm cases).
+ *
+ * Build: make -C bench
+ * Usage: ./lazy_bench [options] [records]
+ */
+
+#include "bench.h"
+
+#define OMEGAJSON_NO_MAIN
+#include "../omegajson.c"
+
+typedef struct {
+    const char* text;
+    size_t length;
+    const char* pointer;
+    OmegaValue* omega;
+    OmegaLazyDocument* doc;
+} LazyState;
+
+// Synthetic document: {"records": [{...} × N], "meta": {...}}
+static char* generate_document(size_t records, size_t* length) {
+    OmegaBuffer buffer = {0};
+    char text[256];
+
+    buffer_append(&buffer, "{\"records\": [", 13);
+    for (size_t i = 0; i < records; i++) {
+        int n = snprintf(text, sizeof(text),
+            "%s{\"id\": %zu, \"name\": \"record-%zu\", \"score\": %.6f, "
+            "\"tags\": [\"alpha\", \"beta\", \"gamma\"], "
+            "\"payload\": {\"x\": %zu, \"y\": %.3f, \"note\": \"line\\nbreak\"}}",
+            i ? ", " : "", i, i, i * 0.731, i * 7, i / 3.0);
+        buffer_append(&buffer, text, n);
+    }
+    int n = snprintf(text, sizeof(text),
+        "], \"meta\": {\"count\": %zu, \"source\": \"synthetic\"}}", records);
+    buffer_append(&buffer, text, n);
+
+    *length = buffer.length;
+    return buffer.data;
+}
+
+static void release(void* state) {
+    LazyState* lazy = state;
+    omega_destroy(lazy->omega);
+    omega_lazy_close(lazy->doc);
+    lazy->omega = NULL;
+    lazy->doc = NULL;
+}
+
+// Full materialization: every node and every metric
+static void run_full_parse(void* state) {
+    LazyState* lazy = state;
+    lazy->omega = omega_parse(lazy->text, lazy->length);
+}
+
+// Structural index alone
+static void run_lazy_index(void* state) {
+    LazyState* lazy = state;
+    lazy->doc = omega_lazy_open(lazy->text, lazy->length);
+}
+
+static void run_lazy_get(void* state) {
+    LazyState* lazy = state;
+    lazy->doc = omega_lazy_open(lazy->text, lazy->length);
+    if (!omega_lazy_get(lazy->doc, lazy->pointer)) {
+        fprintf(stderr, "missing %s\n", lazy->pointer);
+    }
+}
+
+// Second touch of the same path is served from the cache
+static void run_warm_get(void* state) {
+    LazyState* lazy = state;
+    bench_sink = (double)(uintptr_t)omega_lazy_get(lazy->doc, lazy->pointer);
+}
+
+int main(int argc, char** argv) {
+    BenchSuite suite;
+    int first = bench_init(&suite, "lazy", argc, argv, " [records]");
+    if (first < 0) return 2;
+
+    size_t records = first < argc ? strtoul(argv[first], NULL, 10) : 50000;
+    size_t length;
+    char* text = generate_document(records, &length);
+
+    char middle[64];
+    snprintf(middle, sizeof(middle), "/records/%zu/name", records / 2);
+    const struct {
+        const char* name;
+        const char* pointer;
+    } accesses[] = {
+        { "first", "/records/0/name" },
+        { "middle", middle },
+        { "trailing", "/meta/count" },
+    };
+
+    LazyState state = { text, length, NULL, NULL, NULL };
+    BenchCase full = { "full_parse", release, run_full_parse, &state, 1, length };
+    BenchCase index = { "lazy_index", release, run_lazy_index, &state, 1, length };
+    bench_annotate(bench_run(&suite, &full), "bytes_materialized", length);
+    bench_run(&suite, &index);
+    release(&state);
+
+    for (size_t a = 0; a < sizeof(accesses) / sizeof(accesses[0]); a++) {
+        char cold_name[64], warm_name[64];
+        snprintf(cold_name, sizeof(cold_name), "lazy_get/%s", accesses[a].name);
+        snprintf(warm_name, sizeof(warm_name), "warm_get/%s", accesses[a].name);
+        state.pointer = accesses[a].pointer;
+
+        // Bytes parsed to answer the access: lazy cost tracks bytes touched
+        BenchCase cold = { cold_name, release, run_lazy_get, &state, 1, length };
+        BenchResult* result = bench_run(&suite, &cold);
+        if (state.doc) bench_annotate(result, "bytes_materialized", state.doc->bytes_materialized);
+        release(&state);
+
+        state.doc = omega_lazy_open(text, length);
+        omega_lazy_get(state.doc, state.pointer);
+        BenchCase warm = { warm_name, NULL, run_warm_get, &state, 1, 0 };
+        bench_run(&suite, &warm);
+        release(&state);
+    }
+
+    bench_finish(&suite);
+    free(text);
+    return 0;
+}
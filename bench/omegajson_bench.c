@@ -0,0 +1,348 @@
+/*
+ * OmegaJSON Benchmarks - construction, metrics, serialization, parsing,
+ * canonicalization and destruction of OmegaValue trees
+ *
+ * Four synthetic shapes exercise different costs of Ω:
+ *   wide    - one array of many small records (append + recomputation)
+ *   deep    - a long object/array chain (recursion depth)
+ *   numeric - a matrix of doubles (number formatting and parsing)
+ *   string  - one object of long, escaped strings (key scans, escaping)
+ *
+ * JSON files given on the command line are benchmarked as extra corpora
+ * with the same cases; their construct case rebuilds the parsed tree
+ * through append/set. Times are in ns per node.
+ *
+ * Build: make -C bench
+ * Usage: ./omegajson_bench [options] [corpus.json ...]
+ */
+
+#include "bench.h"
+
+#define OMEGAJSON_NO_MAIN
+#include "../omegajson.c"
+
+#include <libgen.h>
+
+typedef struct {
+    char name[96];
+    OmegaValue* (*build)(void);
+    OmegaValue* tree;         // Reference tree, built once
+    OmegaValue* scratch;      // Built / parsed / destroyed by the cases
+    char* text;               // Compact JSON of tree
+    size_t length;
+    size_t nodes;
+    OmegaBuffer buffer;       // Reused by serialize_compact
+    OmegaCanonCache* cache;
+    OmegaLazyDocument* lazy;
+    FILE* null_out;
+} ShapeState;
+
+// ============================================================================
+// SYNTHETIC SHAPES
+// ============================================================================
+
+#define WIDE_RECORDS 1000
+#define DEEP_LEVELS 256
+#define NUMERIC_ROWS 64
+#define NUMERIC_COLUMNS 64
+#define STRING_KEYS 512
+
+static OmegaValue* build_wide(void) {
+    OmegaValue* records = omega_create_array();
+    char name[32];
+
+    for (int i = 0; i < WIDE_RECORDS; i++) {
+        OmegaValue* record = omega_create_object();
+        snprintf(name, sizeof(name), "record-%d", i);
+        omega_object_set(record, "id", omega_create_number(i));
+        omega_object_set(record, "name", omega_create_string(name));
+        omega_object_set(record, "active", omega_create_bool(i % 3 == 0));
+        omega_object_set(record, "parent", omega_create());
+        omega_array_append(records, record);
+    }
+    return records;
+}
+
+static OmegaValue* build_deep(void) {
+    OmegaValue* node = omega_create_string("leaf");
+
+    // Built bottom-up, the way encapsulation Ωₙ₊₁ = {Ωₙ} is expressed
+    for (int level = DEEP_LEVELS - 1; level >= 0; level--) {
+        OmegaValue* object = omega_create_object();
+        OmegaValue* wrapper = omega_create_array();
+        omega_array_append(wrapper, node);
+        omega_object_set(object, "level", omega_create_number(level));
+        omega_object_set(object, "child", wrapper);
+        node = object;
+    }
+    return node;
+}
+
+static OmegaValue* build_numeric(void) {
+    OmegaValue* matrix = omega_create_array();
+    uint64_t seed = 0x9e3779b97f4a7c15ULL;
+
+    for (int r = 0; r < NUMERIC_ROWS; r++) {
+        OmegaValue* row = omega_create_array();
+        for (int c = 0; c < NUMERIC_COLUMNS; c++) {
+            seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+            double value = (double)(seed >> 11) / (double)(1ULL << 53);
+            // Mix integers, short decimals and full-precision doubles
+            if (c % 3 == 0) value = (double)(int64_t)(value * 1e6);
+            else if (c % 3 == 1) value = round(value * 1e3) / 1e3 - 0.5;
+            else value = value * 1e-3 - 5e-4;
+            omega_array_append(row, omega_create_number(value));
+        }
+        omega_array_append(matrix, row);
+    }
+    return matrix;
+}
+
+static OmegaValue* build_string(void) {
+    OmegaValue* object = omega_create_object();
+    char key[32], value[128];
+
+    for (int i = 0; i < STRING_KEYS; i++) {
+        snprintf(key, sizeof(key), "key-%04d", i);
+        snprintf(value, sizeof(value),
+                 "value %d: \"quoted\" text with a tab\t, a newline\n and path C:\\omega\\%d",
+                 i, i * 7);
+        omega_object_set(object, key, omega_create_string(value));
+    }
+    return object;
+}
+
+// Corpora have no builder: rebuild the parsed tree bottom-up through
+// append/set, which recompute metrics on every insert
+static OmegaValue* rebuild(const OmegaValue* omega) {
+    if (!omega) return omega_create();
+    switch (omega->type) {
+        case OMEGA_BOOL:
+            return omega_create_bool(omega->data.boolean);
+        case OMEGA_NUMBER:
+            return omega_create_number(omega->data.number);
+        case OMEGA_STRING:
+            return omega_create_string(omega->data.string);
+        case OMEGA_ARRAY: {
+            OmegaValue* array = omega_create_array();
+            for (size_t i = 0; i < omega->data.array.count; i++) {
+                omega_array_append(array, rebuild(omega->data.array.elements[i]));
+            }
+            return array;
+        }
+        case OMEGA_OBJECT: {
+            OmegaValue* object = omega_create_object();
+            for (size_t i = 0; i < omega->data.object->count; i++) {
+                const OmegaEntry* entry = &omega->data.object->entries[i];
+                omega_object_set(object, entry->key, rebuild(entry->value));
+            }
+            return object;
+        }
+        default:
+            return omega_create();
+    }
+}
+
+static size_t count_nodes(const OmegaValue* omega) {
+    size_t count = 1;
+    if (!omega) return count;
+    if (omega->type == OMEGA_ARRAY) {
+        for (size_t i = 0; i < omega->data.array.count; i++) {
+            count += count_nodes(omega->data.array.elements[i]);
+        }
+    } else if (omega->type == OMEGA_OBJECT) {
+        for (size_t i = 0; i < omega->data.object->count; i++) {
+            count += count_nodes(omega->data.object->entries[i].value);
+        }
+    }
+    return count;
+}
+
+// ============================================================================
+// CASES
+// ============================================================================
+
+static void drop_scratch(void* state) {
+    ShapeState* shape = state;
+    omega_destroy(shape->scratch);
+    shape->scratch = NULL;
+}
+
+static void run_construct(void* state) {
+    ShapeState* shape = state;
+    shape->scratch = shape->build ? shape->build() : rebuild(shape->tree);
+}
+
+static void run_metrics(void* state) {
+    ShapeState* shape = state;
+    bench_sink = calculate_complexity(shape->tree)
+               + calculate_entropy(shape->tree)
+               + calculate_symmetry_hash(shape->tree);
+}
+
+static void run_serialize(void* state) {
+    ShapeState* shape = state;
+    omega_serialize(shape->tree, shape->null_out);
+}
+
+static void run_serialize_compact(void* state) {
+    ShapeState* shape = state;
+    shape->buffer.length = 0;
+    omega_serialize_compact(shape->tree, &shape->buffer);
+    bench_sink = shape->buffer.length;
+}
+
+static void run_parse(void* state) {
+    ShapeState* shape = state;
+    shape->scratch = omega_parse(shape->text, shape->length);
+}
+
+static void prepare_destroy(void* state) {
+    ShapeState* shape = state;
+    omega_destroy(shape->scratch);
+    shape->scratch = omega_parse(shape->text, shape->length);
+}
+
+static void run_destroy(void* state) {
+    drop_scratch(state);
+}
+
+// A canonicalized tree keeps its sorted keys and trusted hashes, so a cold
+// pass needs a freshly parsed tree as well as an empty cache
+static void prepare_canonicalize_cold(void* state) {
+    ShapeState* shape = state;
+    omega_destroy(shape->tree);
+    shape->tree = omega_parse(shape->text, shape->length);
+    if (shape->cache) omega_canon_cache_destroy(shape->cache);
+    shape->cache = omega_canon_cache_create();
+}
+
+static void run_canonicalize(void* state) {
+    ShapeState* shape = state;
+    bench_sink = (double)(uintptr_t)omega_canonicalize(shape->tree, shape->cache);
+}
+
+static void prepare_lazy_open(void* state) {
+    ShapeState* shape = state;
+    omega_lazy_close(shape->lazy);
+    shape->lazy = NULL;
+}
+
+static void run_lazy_open(void* state) {
+    ShapeState* shape = state;
+    shape->lazy = omega_lazy_open(shape->text, shape->length);
+}
+
+static void shape_init(ShapeState* shape, OmegaValue* tree) {
+    shape->tree = tree;
+    shape->nodes = count_nodes(tree);
+    shape->null_out = fopen("/dev/null", "w");
+    shape->cache = omega_canon_cache_create();
+
+    OmegaBuffer buffer = {0};
+    omega_serialize_compact(tree, &buffer);
+    shape->text = buffer.data;
+    shape->length = buffer.length;
+}
+
+static void shape_free(ShapeState* shape) {
+    omega_destroy(shape->tree);
+    omega_destroy(shape->scratch);
+    omega_lazy_close(shape->lazy);
+    if (shape->cache) omega_canon_cache_destroy(shape->cache);
+    fclose(shape->null_out);
+    free(shape->buffer.data);
+    free(shape->text);
+}
+
+static void run_case(BenchSuite* suite, ShapeState* shape, const char* label,
+                     void (*prepare)(void*), void (*run)(void*), size_t bytes) {
+    char name[160];
+    snprintf(name, sizeof(name), "%s/%s", shape->name, label);
+    BenchCase bench = { name, prepare, run, shape, shape->nodes, bytes };
+    bench_run(suite, &bench);
+    drop_scratch(shape);
+}
+
+static void bench_shape(BenchSuite* suite, ShapeState* shape) {
+    run_case(suite, shape, "construct", drop_scratch, run_construct, 0);
+    run_case(suite, shape, "metrics", NULL, run_metrics, 0);
+    run_case(suite, shape, "serialize", NULL, run_serialize, 0);
+    run_case(suite, shape, "serialize_compact", NULL, run_serialize_compact, shape->length);
+    run_case(suite, shape, "parse", drop_scratch, run_parse, shape->length);
+    run_case(suite, shape, "destroy", prepare_destroy, run_destroy, 0);
+    run_case(suite, shape, "lazy_open", prepare_lazy_open, run_lazy_open, shape->length);
+
+    // Canonicalization sorts keys in place, so it runs last
+    run_case(suite, shape, "canonicalize_cold", prepare_canonicalize_cold, run_canonicalize, 0);
+    run_case(suite, shape, "canonicalize_warm", NULL, run_canonicalize, 0);
+}
+
+static char* read_file(const char* path, size_t* length) {
+    FILE* in = fopen(path, "rb");
+    if (!in) return NULL;
+
+    OmegaBuffer buffer = {0};
+    char chunk[65536];
+    size_t n;
+    while ((n = fread(chunk, 1, sizeof(chunk), in)) > 0) buffer_append(&buffer, chunk, n);
+    fclose(in);
+
+    *length = buffer.length;
+    return buffer.data;
+}
+
+int main(int argc, char** argv) {
+    BenchSuite suite;
+    int first = bench_init(&suite, "omegajson", argc, argv, " [corpus.json ...]");
+    if (first < 0) return 2;
+
+    struct {
+        const char* name;
+        OmegaValue* (*build)(void);
+    } shapes[] = {
+        { "wide", build_wide },
+        { "deep", build_deep },
+        { "numeric", build_numeric },
+        { "string", build_string },
+    };
+
+    for (size_t s = 0; s < sizeof(shapes) / sizeof(shapes[0]); s++) {
+        ShapeState shape = {0};
+        snprintf(shape.name, sizeof(shape.name), "%s", shapes[s].name);
+        shape.build = shapes[s].build;
+        shape_init(&shape, shape.build());
+        bench_shape(&suite, &shape);
+        shape_free(&shape);
+    }
+
+    // Corpora are not vendored; pass standard documents (twitter.json,
+    // citm_catalog.json, canada.json, ...) as arguments
+    for (int i = first; i < argc; i++) {
+        size_t length;
+        char* text = read_file(argv[i], &length);
+        OmegaValue* tree = text ? omega_parse(text, length) : NULL;
+        if (!tree) {
+            fprintf(stderr, "%s: unreadable or invalid JSON, skipped\n", argv[i]);
+            free(text);
+            continue;
+        }
+
+        ShapeState shape = {0};
+        char* path = strdup(argv[i]);
+        snprintf(shape.name, sizeof(shape.name), "corpus:%s", basename(path));
+        free(path);
+        shape_init(&shape, tree);
+
+        // Benchmark the file's own bytes rather than our re-encoding
+        free(shape.text);
+        shape.text = text;
+        shape.length = length;
+
+        bench_shape(&suite, &shape);
+        shape_free(&shape);
+    }
+
+    bench_finish(&suite);
+    return 0;
+}
@@ -0,0 +1,692 @@
+/*
+ * OmegaIngest - Pipelined NDJSON ingestion of OmegaJSON records
+ *
+ * Each input line is one record Ω. The pipeline computes, per record, the
+ * symmetry hash (Ω/G), complexity L(ω) and entropy H(Ω) exactly as
+ * omegajson.c defines them, and optionally drops records whose canonical
+ * form ω* has already been seen (Ω/~).
+ *
+ * Stages:
+ * - Reader: large sequential read()s into batch buffers, cut at the last
+ *   newline so no record straddles two batches. A batch is handed over
+ *   early when the input goes idle (a live pipe or socket), so complete
+ *   records are not held back until the chunk fills
+ * - Workers: parse each line into a per-worker arena (reset after every
+ *   record), serialize it with its metrics into the batch's output buffer
+ * - Sink: writes batches in input order (default) or as they complete,
+ *   deduplicating on canonical form (hash, confirmed by bytes) when asked to
+ *
+ * Stages hand batches over bounded lock-free MPMC queues; a stage that
+ * finds its queue empty (or full) spins briefly and then sleeps on the
+ * queue's condition variable until the other side moves. A fixed pool of
+ * batches circulates reader → workers → sink → reader, which bounds memory
+ * and makes a slow sink stall the reader (backpressure).
+ *
+ * Build: cc -O2 -pthread -o omegaingest omegaingest.c -lm
+ *        (add -DOMEGA_PROFILE to print omegajson counters on exit)
+ * Usage: omegaingest [-w workers] [-o output] [-u] [-d] [-b KiB] [input]
+ *        omegaingest -s [-w max_workers] input     (scaling report)
+ */
+
+#define _GNU_SOURCE
+#define OMEGAJSON_NO_MAIN
+#include "omegajson.c"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+// ============================================================================
+// BOUNDED LOCK-FREE QUEUE (MPMC ring with per-cell sequence numbers)
+// ============================================================================
+
+typedef struct {
+    _Atomic size_t sequence;
+    void* item;
+} IngestCell;
+
+typedef struct {
+    IngestCell* cells;
+    size_t mask;
+    _Alignas(64) _Atomic size_t head;  // Next position to push
+    _Alignas(64) _Atomic size_t tail;  // Next position to pop
+    _Alignas(64) _Atomic int waiters;  // Threads blocked in push or pop
+    pthread_mutex_t lock;
+    pthread_cond_t changed;
+} IngestQueue;
+
+// Tries (with sched_yield between them) before a waiting stage blocks, so
+// idle stages do not take CPU from working ones
+#define QUEUE_SPINS 32
+
+static void queue_init(IngestQueue* queue, size_t minimum) {
+    size_t capacity = 2;
+    while (capacity < minimum) capacity *= 2;
+
+    queue->cells = calloc(capacity, sizeof(IngestCell));
+    queue->mask = capacity - 1;
+    for (size_t i = 0; i < capacity; i++) {
+        atomic_store_explicit(&queue->cells[i].sequence, i, memory_order_relaxed);
+    }
+    atomic_store(&queue->head, 0);
+    atomic_store(&queue->tail, 0);
+    atomic_store(&queue->waiters, 0);
+    pthread_mutex_init(&queue->lock, NULL);
+    pthread_cond_init(&queue->changed, NULL);
+}
+
+static void queue_destroy(IngestQueue* queue) {
+    pthread_mutex_destroy(&queue->lock);
+    pthread_cond_destroy(&queue->changed);
+    free(queue->cells);
+}
+
+static bool queue_try_push(IngestQueue* queue, void* item) {
+    size_t position = atomic_load_explicit(&queue->head, memory_order_relaxed);
+
+    for (;;) {
+        IngestCell* cell = &queue->cells[position & queue->mask];
+        size_t sequence = atomic_load_explicit(&cell->sequence, memory_order_acquire);
+        intptr_t diff = (intptr_t)sequence - (intptr_t)position;
+
+        if (diff == 0) {
+            if (atomic_compare_exchange_weak_explicit(&queue->head, &position, position + 1,
+                                                      memory_order_relaxed,
+                                                      memory_order_relaxed)) {
+                cell->item = item;
+                atomic_store_explicit(&cell->sequence, position + 1, memory_order_release);
+                return true;
+            }
+        } else if (diff < 0) {
+            return false;  // Full
+        } else {
+            position = atomic_load_explicit(&queue->head, memory_order_relaxed);
+        }
+    }
+}
+
+static bool queue_try_pop(IngestQueue* queue, void** item) {
+    size_t position = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+
+    for (;;) {
+        IngestCell* cell = &queue->cells[position & queue->mask];
+        size_t sequence = atomic_load_explicit(&cell->sequence, memory_order_acquire);
+        intptr_t diff = (intptr_t)sequence - (intptr_t)(position + 1);
+
+        if (diff == 0) {
+            if (atomic_compare_exchange_weak_explicit(&queue->tail, &position, position + 1,
+                                                      memory_order_relaxed,
+                                                      memory_order_relaxed)) {
+                *item = cell->item;
+                atomic_store_explicit(&cell->sequence, position + queue->mask + 1,
+                                      memory_order_release);
+                return true;
+            }
+        } else if (diff < 0) {
+            return false;  // Empty
+        } else {
+            position = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+        }
+    }
+}
+
+// Wake blocked threads after a successful push or pop. The fence pairs
+// with the one in queue_block: either the waiter's retry sees this change
+// or this load sees the waiter.
+static void queue_wake(IngestQueue* queue) {
+    atomic_thread_fence(memory_order_seq_cst);
+    if (atomic_load_explicit(&queue->waiters, memory_order_relaxed)) {
+        pthread_mutex_lock(&queue->lock);
+        pthread_cond_broadcast(&queue->changed);
+        pthread_mutex_unlock(&queue->lock);
+    }
+}
+
+// Spin briefly, then sleep until another thread changes the queue
+static void queue_block(IngestQueue* queue, bool (*attempt)(IngestQueue*, void**),
+                        void** item) {
+    for (int spin = 0; spin < QUEUE_SPINS; spin++) {
+        if (attempt(queue, item)) return;
+        sched_yield();
+    }
+
+    pthread_mutex_lock(&queue->lock);
+    atomic_fetch_add(&queue->waiters, 1);
+    atomic_thread_fence(memory_order_seq_cst);
+    while (!attempt(queue, item)) pthread_cond_wait(&queue->changed, &queue->lock);
+    atomic_fetch_sub(&queue->waiters, 1);
+    pthread_mutex_unlock(&queue->lock);
+}
+
+static bool queue_attempt_push(IngestQueue* queue, void** item) {
+    return queue_try_push(queue, *item);
+}
+
+static void queue_push(IngestQueue* queue, void* item) {
+    queue_block(queue, queue_attempt_push, &item);
+    queue_wake(queue);
+}
+
+static void* queue_pop(IngestQueue* queue) {
+    void* item;
+    queue_block(queue, queue_try_pop, &item);
+    queue_wake(queue);
+    return item;
+}
+
+// ============================================================================
+// BATCHES (unit of work flowing through the pipeline)
+// ============================================================================
+
+typedef struct {
+    size_t offset;            // Into the batch output
+    size_t length;
+    uint64_t canonical_hash;  // ω* identity, 0 unless deduplicating
+    size_t canonical_offset;  // ω* bytes in the batch's canonical buffer
+    size_t canonical_length;
+} IngestRecord;
+
+typedef struct {
+    size_t sequence;
+    char* input;
+    size_t input_length;
+    size_t input_capacity;
+    OmegaBuffer output;       // Reused across batches
+    OmegaBuffer canonical;    // Canonical encodings, when deduplicating
+    IngestRecord* records;
+    size_t record_count;
+    size_t record_capacity;
+    size_t malformed;
+} IngestBatch;
+
+// Sent once per worker to shut the pipeline down
+static IngestBatch ingest_end;
+
+static void batch_reserve_input(IngestBatch* batch, size_t capacity) {
+    if (batch->input_capacity >= capacity) return;
+    batch->input = realloc(batch->input, capacity);
+    batch->input_capacity = capacity;
+}
+
+static IngestRecord* batch_add_record(IngestBatch* batch) {
+    if (batch->record_count >= batch->record_capacity) {
+        batch->record_capacity = batch->record_capacity ? batch->record_capacity * 2 : 256;
+        batch->records = realloc(batch->records, batch->record_capacity * sizeof(IngestRecord));
+    }
+    return &batch->records[batch->record_count++];
+}
+
+static void batch_destroy(IngestBatch* batch) {
+    free(batch->input);
+    free(batch->output.data);
+    free(batch->canonical.data);
+    free(batch->records);
+    free(batch);
+}
+
+// ============================================================================
+// PIPELINE
+// ============================================================================
+
+typedef struct {
+    int input_fd;
+    FILE* output;
+    int workers;
+    bool ordered;
+    bool dedup;
+    bool flush_batches;  // Output is a pipe or terminal: flush every batch
+    size_t batch_size;
+} IngestOptions;
+
+typedef struct {
+    size_t records;
+    size_t malformed;
+    size_t duplicates;
+    size_t bytes_in;
+    size_t bytes_out;
+    double seconds;
+    int read_error;  // errno of a failed read(), 0 if none
+} IngestStats;
+
+typedef struct {
+    const IngestOptions* options;
+    IngestQueue free_batches;
+    IngestQueue work;
+    IngestQueue done;
+    int read_error;  // Reader's errno; read after the reader is joined
+} IngestPipeline;
+
+// Per-worker state, kept for the whole run
+typedef struct {
+    IngestPipeline* pipeline;
+    OmegaArena* arena;       // Record trees, reset after every record
+    OmegaBuffer scratch;     // Parser string decoding space
+    OmegaCanonCache* cache;  // ω* classes, bounded by INGEST_CANON_NODES
+} IngestWorker;
+
+// Record trees die with the arena and their ω* bytes are copied out, so
+// cached classes are never reused; a small bound keeps the cache hot
+#define INGEST_CANON_NODES 4096
+
+static void* reader_main(void* arg) {
+    IngestPipeline* pipeline = arg;
+    const IngestOptions* options = pipeline->options;
+    char* carry = NULL;
+    size_t carry_length = 0;
+    size_t sequence = 0;
+    bool eof = false;
+
+    posix_fadvise(options->input_fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+    while (!eof) {
+        IngestBatch* batch = queue_pop(&pipeline->free_batches);
+
+        // Start from the partial line the previous chunk ended with
+        batch_reserve_input(batch, carry_length + options->batch_size);
+        if (carry_length) memcpy(batch->input, carry, carry_length);
+        batch->input_length = carry_length;
+        carry_length = 0;
+
+        for (;;) {
+            ssize_t n = read(options->input_fd, batch->input + batch->input_length,
+                             batch->input_capacity - batch->input_length);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) {
+                if (n < 0) pipeline->read_error = errno;
+                eof = true;
+                break;
+            }
+            batch->input_length += n;
+
+            // A short read with nothing more pending means the writer is
+            // idle: pass on the complete records now instead of waiting
+            if (batch->input_length < batch->input_capacity) {
+                struct pollfd ready = { .fd = options->input_fd, .events = POLLIN };
+                if (poll(&ready, 1, 0) > 0) continue;
+            }
+
+            char* newline = memrchr(batch->input, '\n', batch->input_length);
+            if (newline) {
+                size_t keep = newline + 1 - batch->input;
+                carry_length = batch->input_length - keep;
+                carry = realloc(carry, carry_length ? carry_length : 1);
+                memcpy(carry, newline + 1, carry_length);
+                batch->input_length = keep;
+                break;
+            }
+            // A single record longer than the chunk
+            if (batch->input_length == batch->input_capacity) {
+                batch_reserve_input(batch, batch->input_capacity * 2);
+            }
+        }
+
+        batch->sequence = sequence++;
+        queue_push(&pipeline->work, batch);
+    }
+
+    free(carry);
+    for (int i = 0; i < options->workers; i++) queue_push(&pipeline->work, &ingest_end);
+    return NULL;
+}
+
+static void ingest_process(IngestWorker* worker, IngestBatch* batch) {
+    const char* cursor = batch->input;
+    const char* end = batch->input + batch->input_length;
+    char text[64];
+
+    batch->output.length = 0;
+    batch->canonical.length = 0;
+    batch->record_count = 0;
+    batch->malformed = 0;
+
+    while (cursor < end) {
+        const char* newline = memchr(cursor, '\n', end - cursor);
+        const char* line_end = newline ? newline : end;
+        const char* first = cursor;
+        while (first < line_end && (*first == ' ' || *first == '\t' || *first == '\r')) first++;
+
+        if (first < line_end) {
+            OmegaValue* omega = omega_parse_arena(first, line_end - first,
+                                                  worker->arena, &worker->scratch);
+            if (!omega) {
+                batch->malformed++;
+            } else {
+                IngestRecord* record = batch_add_record(batch);
+                record->offset = batch->output.length;
+
+                buffer_append(&batch->output, "{\"record\":", 10);
+                omega_serialize_compact(omega, &batch->output);
+                int n = snprintf(text, sizeof(text), ",\"symmetry_hash\":%u,\"complexity\":",
+                                 omega->symmetry_hash);
+                buffer_append(&batch->output, text, n);
+                buffer_append_number(&batch->output, omega->complexity);
+                n = snprintf(text, sizeof(text), ",\"entropy\":%u}\n", omega->entropy);
+                buffer_append(&batch->output, text, n);
+
+                record->length = batch->output.length - record->offset;
+                // After the metrics are taken: canonicalization rewrites the tree
+                record->canonical_hash = 0;
+                if (worker->cache) {
+                    const OmegaCanon* canon = omega_canonicalize(omega, worker->cache);
+                    record->canonical_hash = canon->hash;
+                    record->canonical_offset = batch->canonical.length;
+                    canon_serialize_internal(canon, &batch->canonical);
+                    record->canonical_length = batch->canonical.length - record->canonical_offset;
+                }
+            }
+            omega_arena_reset(worker->arena);
+        }
+        cursor = line_end + 1;
+    }
+}
+
+static void* worker_main(void* arg) {
+    IngestWorker* worker = arg;
+    IngestPipeline* pipeline = worker->pipeline;
+
+    for (;;) {
+        IngestBatch* batch = queue_pop(&pipeline->work);
+        if (batch != &ingest_end) ingest_process(worker, batch);
+        queue_push(&pipeline->done, batch);
+        if (batch == &ingest_end) return NULL;
+    }
+}
+
+// Open-addressed set of canonical forms, keyed by hash (0 never occurs,
+// see canon_hash_node). A hash match is confirmed on the canonical bytes,
+// so colliding but distinct records are both kept.
+typedef struct {
+    uint64_t hash;
+    char* bytes;
+    size_t length;
+} IngestSeenSlot;
+
+typedef struct {
+    IngestSeenSlot* slots;
+    size_t capacity;
+    size_t count;
+} IngestSeen;
+
+static void seen_place(IngestSeen* seen, IngestSeenSlot entry) {
+    size_t slot = entry.hash & (seen->capacity - 1);
+    while (seen->slots[slot].hash) slot = (slot + 1) & (seen->capacity - 1);
+    seen->slots[slot] = entry;
+    seen->count++;
+}
+
+// Returns false if an identical canonical form was inserted before
+static bool seen_insert(IngestSeen* seen, uint64_t hash, const char* bytes, size_t length) {
+    if ((seen->count + 1) * 2 > seen->capacity) {
+        IngestSeenSlot* old = seen->slots;
+        size_t old_capacity = seen->capacity;
+
+        seen->capacity = old_capacity ? old_capacity * 2 : 1024;
+        seen->slots = calloc(seen->capacity, sizeof(IngestSeenSlot));
+        seen->count = 0;
+        for (size_t i = 0; i < old_capacity; i++) {
+            if (old[i].hash) seen_place(seen, old[i]);
+        }
+        free(old);
+    }
+
+    for (size_t slot = hash & (seen->capacity - 1); seen->slots[slot].hash;
+         slot = (slot + 1) & (seen->capacity - 1)) {
+        const IngestSeenSlot* entry = &seen->slots[slot];
+        if (entry->hash == hash && entry->length == length &&
+            memcmp(entry->bytes, bytes, length) == 0) {
+            return false;
+        }
+    }
+
+    IngestSeenSlot entry = { hash, malloc(length ? length : 1), length };
+    memcpy(entry.bytes, bytes, length);
+    seen_place(seen, entry);
+    return true;
+}
+
+static void seen_free(IngestSeen* seen) {
+    for (size_t i = 0; i < seen->capacity; i++) free(seen->slots[i].bytes);
+    free(seen->slots);
+}
+
+static void sink_write(IngestPipeline* pipeline, IngestBatch* batch, IngestStats* stats,
+                       IngestSeen* seen) {
+    FILE* out = pipeline->options->output;
+
+    if (seen) {
+        for (size_t i = 0; i < batch->record_count; i++) {
+            const IngestRecord* record = &batch->records[i];
+            if (!seen_insert(seen, record->canonical_hash,
+                             batch->canonical.data + record->canonical_offset,
+                             record->canonical_length)) {
+                stats->duplicates++;
+                continue;
+            }
+            fwrite(batch->output.data + record->offset, 1, record->length, out);
+            stats->bytes_out += record->length;
+        }
+    } else if (batch->output.length) {
+        fwrite(batch->output.data, 1, batch->output.length, out);
+        stats->bytes_out += batch->output.length;
+    }
+
+    stats->records += batch->record_count;
+    stats->malformed += batch->malformed;
+    stats->bytes_in += batch->input_length;
+    if (pipeline->options->flush_batches) fflush(out);
+    queue_push(&pipeline->free_batches, batch);
+}
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static IngestStats ingest_run(const IngestOptions* options) {
+    IngestStats stats = {0};
+    IngestSeen seen = {0};
+    IngestPipeline pipeline = { .options = options };
+    size_t pool = (size_t)options->workers * 2 + 2;
+
+    queue_init(&pipeline.free_batches, pool);
+    queue_init(&pipeline.work, pool + options->workers);
+    queue_init(&pipeline.done, pool + options->workers);
+
+    IngestBatch** batches = calloc(pool, sizeof(IngestBatch*));
+    IngestBatch** pending = calloc(pool, sizeof(IngestBatch*));
+    for (size_t i = 0; i < pool; i++) {
+        batches[i] = calloc(1, sizeof(IngestBatch));
+        queue_push(&pipeline.free_batches, batches[i]);
+    }
+
+    double start = now_seconds();
+
+    pthread_t reader;
+    pthread_t* workers = calloc(options->workers, sizeof(pthread_t));
+    IngestWorker* states = calloc(options->workers, sizeof(IngestWorker));
+    pthread_create(&reader, NULL, reader_main, &pipeline);
+    for (int i = 0; i < options->workers; i++) {
+        states[i].pipeline = &pipeline;
+        states[i].arena = omega_arena_create(0);
+        states[i].cache = options->dedup ? omega_canon_cache_create() : NULL;
+        if (states[i].cache) states[i].cache->max_nodes = INGEST_CANON_NODES;
+        pthread_create(&workers[i], NULL, worker_main, &states[i]);
+    }
+
+    // Sink: batches in flight never exceed the pool, so a ring of that
+    // size is enough to restore input order
+    size_t next = 0;
+    for (int finished = 0; finished < options->workers;) {
+        IngestBatch* batch = queue_pop(&pipeline.done);
+        if (batch == &ingest_end) {
+            finished++;
+            continue;
+        }
+        if (!options->ordered) {
+            sink_write(&pipeline, batch, &stats, options->dedup ? &seen : NULL);
+            continue;
+        }
+        pending[batch->sequence % pool] = batch;
+        while ((batch = pending[next % pool]) && batch->sequence == next) {
+            pending[next % pool] = NULL;
+            sink_write(&pipeline, batch, &stats, options->dedup ? &seen : NULL);
+            next++;
+        }
+    }
+
+    pthread_join(reader, NULL);
+    for (int i = 0; i < options->workers; i++) pthread_join(workers[i], NULL);
+    fflush(options->output);
+
+    stats.seconds = now_seconds() - start;
+    stats.read_error = pipeline.read_error;
+
+    for (int i = 0; i < options->workers; i++) {
+        omega_arena_destroy(states[i].arena);
+        omega_canon_cache_destroy(states[i].cache);
+        free(states[i].scratch.data);
+    }
+    for (size_t i = 0; i < pool; i++) batch_destroy(batches[i]);
+    free(batches);
+    free(pending);
+    free(states);
+    free(workers);
+    seen_free(&seen);
+    queue_destroy(&pipeline.free_batches);
+    queue_destroy(&pipeline.work);
+    queue_destroy(&pipeline.done);
+    return stats;
+}
+
+// ============================================================================
+// COMMAND LINE
+// ============================================================================
+
+static void print_usage(const char* program) {
+    fprintf(stderr,
+        "Usage: %s [-w workers] [-o output] [-u] [-d] [-b KiB] [input]\n"
+        "       %s -s [-w max_workers] input\n"
+        "  -w  parse/metric workers (default: online CPUs)\n"
+        "  -o  output file (default: stdout)\n"
+        "  -u  unordered sink: write batches as they complete\n"
+        "  -d  drop records whose canonical form was already written\n"
+        "  -b  read chunk size in KiB (default: 4096)\n"
+        "  -s  scaling report: records/s and GB/s for 1..max workers\n",
+        program, program);
+}
+
+static void print_rate(const char* label, const IngestStats* stats) {
+    fprintf(stderr, "%-8s %12zu records %10.3f s %14.0f records/s %8.3f GB/s\n",
+            label, stats->records, stats->seconds,
+            stats->records / stats->seconds, stats->bytes_in / stats->seconds / 1e9);
+}
+
+int main(int argc, char** argv) {
+    IngestOptions options = {
+        .input_fd = STDIN_FILENO,
+        .output = stdout,
+        .workers = (int)sysconf(_SC_NPROCESSORS_ONLN),
+        .ordered = true,
+        .dedup = false,
+        .flush_batches = false,
+        .batch_size = 4096 * 1024
+    };
+    bool scale = false;
+    const char* output_path = NULL;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "w:o:udb:sh")) != -1) {
+        switch (opt) {
+            case 'w': options.workers = atoi(optarg); break;
+            case 'o': output_path = optarg; break;
+            case 'u': options.ordered = false; break;
+            case 'd': options.dedup = true; break;
+            case 'b': options.batch_size = strtoul(optarg, NULL, 10) * 1024; break;
+            case 's': scale = true; break;
+            default:
+                print_usage(argv[0]);
+                return opt == 'h' ? 0 : 2;
+        }
+    }
+    if (options.workers < 1) options.workers = 1;
+    if (options.batch_size < 4096) options.batch_size = 4096;
+
+    const char* input_path = optind < argc ? argv[optind] : NULL;
+    if (scale && !input_path) {
+        print_usage(argv[0]);
+        return 2;
+    }
+
+    if (scale) {
+        int max_workers = options.workers;
+        double baseline = 0;
+
+        options.output = fopen("/dev/null", "w");
+        fprintf(stderr, "workers %12s %12s %16s %13s %8s\n",
+                "records", "seconds", "records/s", "GB/s", "speedup");
+        for (int workers = 1;; workers = workers * 2 > max_workers ? max_workers : workers * 2) {
+            options.workers = workers;
+            options.input_fd = open(input_path, O_RDONLY);
+            if (options.input_fd < 0) {
+                perror(input_path);
+                return 1;
+            }
+            IngestStats stats = ingest_run(&options);
+            close(options.input_fd);
+
+            double rate = stats.records / stats.seconds;
+            if (workers == 1) baseline = rate;
+            fprintf(stderr, "%7d %12zu %12.3f %16.0f %13.3f %7.2fx\n",
+                    workers, stats.records, stats.seconds, rate,
+                    stats.bytes_in / stats.seconds / 1e9, rate / baseline);
+            if (workers == max_workers) break;
+        }
+        fclose(options.output);
+        return 0;
+    }
+
+    if (input_path) {
+        options.input_fd = open(input_path, O_RDONLY);
+        if (options.input_fd < 0) {
+            perror(input_path);
+            return 1;
+        }
+    }
+    if (output_path) {
+        options.output = fopen(output_path, "w");
+        if (!options.output) {
+            perror(output_path);
+            return 1;
+        }
+    }
+    setvbuf(options.output, NULL, _IOFBF, 1 << 20);
+
+    struct stat output_stat;
+    options.flush_batches = fstat(fileno(options.output), &output_stat) == 0 &&
+                            !S_ISREG(output_stat.st_mode);
+
+    IngestStats stats = ingest_run(&options);
+
+    print_rate("ingest", &stats);
+    fprintf(stderr, "malformed=%zu duplicates=%zu bytes_in=%zu bytes_out=%zu\n",
+            stats.malformed, stats.duplicates, stats.bytes_in, stats.bytes_out);
+
+#ifdef OMEGA_PROFILE
+    omega_profile_dump(stderr);
+#endif
+
+    if (output_path) fclose(options.output);
+    if (input_path) close(options.input_fd);
+    if (stats.read_error) {
+        fprintf(stderr, "read: %s\n", strerror(stats.read_error));
+        return 1;
+    }
+    return 0;
+}
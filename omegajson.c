@@ -17,6 +17,7 @@
 #include <string.h>
 #include <stdint.h>
 #include <stdbool.h>
+#include <stdatomic.h>
 #include <math.h>
 
 // ============================================================================
@@ -36,6 +37,7 @@ typedef enum {
 // Forward declaration for recursive structure
 typedef struct OmegaValue OmegaValue;
 typedef struct OmegaObject OmegaObject;
+typedef struct OmegaCanon OmegaCanon;
 
 // Ω-Value: Recursive encapsulation structure
 struct OmegaValue {
@@ -60,6 +62,10 @@ struct OmegaValue {
     // Reflective convergence metadata
     uint32_t recursion_depth;
     bool is_canonical;  // Ω/~ equivalence class representative
+    uint64_t canonical_hash;  // ω* identity, 0 until canonicalized
+    const OmegaCanon* canonical;  // Memoized ω*, valid for canonical_epoch only
+    uint64_t canonical_epoch;
+    OmegaValue* parent;  // Enclosing container, for invalidation
 };
 
 // Object entry (key-value pair in Ω)
@@ -77,12 +83,180 @@ struct OmegaObject {
     uint32_t symmetry_group;  // Group G identifier
 };
 
+// ============================================================================
+// INSTRUMENTATION (observing the cost of Ω)
+// ============================================================================
+
+/*
+ * Build with -DOMEGA_PROFILE to count node lifetimes per OmegaType,
+ * allocations, realloc growth, metric recomputation and key-scan probe
+ * lengths. Allocations are counted where malloc/calloc/realloc/strdup is
+ * called: nodes, child arrays, OmegaBuffer growth (parsed strings and keys,
+ * serialization), arena chunks, canon-cache nodes and the lazy index.
+ * bytes_allocated is bytes requested plus bytes added by growth.
+ *
+ * Add -DOMEGA_PROFILE_TIMERS for inclusive cycle counts around every
+ * public entry point (GCC/Clang). Without these flags every hook expands
+ * to nothing.
+ *
+ * Counters live in a per-thread block written only by its owner thread;
+ * omega_profile_snapshot() sums all blocks. Blocks are never freed, so
+ * counts from finished threads remain in the totals.
+ */
+
+#define OMEGA_TYPE_COUNT (OMEGA_REFERENCE + 1)
+#define OMEGA_PROBE_BUCKETS 16
+
+typedef enum {
+    OMEGA_ENTRY_CREATE,
+    OMEGA_ENTRY_ARRAY_APPEND,
+    OMEGA_ENTRY_OBJECT_SET,
+    OMEGA_ENTRY_OBJECT_GET,
+    OMEGA_ENTRY_SERIALIZE,
+    OMEGA_ENTRY_SERIALIZE_COMPACT,
+    OMEGA_ENTRY_SERIALIZE_CANONICAL,
+    OMEGA_ENTRY_DESTROY,
+    OMEGA_ENTRY_CANONICALIZE,
+    OMEGA_ENTRY_PARSE,
+    OMEGA_ENTRY_POINTER_GET,
+    OMEGA_ENTRY_LAZY_OPEN,
+    OMEGA_ENTRY_LAZY_GET,
+    OMEGA_ENTRY_COUNT
+} OmegaProfileEntry;
+
+#ifdef OMEGA_PROFILE
+
+#include <stddef.h>
+#include <time.h>
+#if defined(OMEGA_PROFILE_TIMERS) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#endif
+
+typedef struct OmegaProfileCounters {
+    _Atomic uint64_t nodes_created[OMEGA_TYPE_COUNT];
+    _Atomic uint64_t nodes_destroyed[OMEGA_TYPE_COUNT];
+    _Atomic uint64_t allocations;
+    _Atomic uint64_t bytes_allocated;
+    _Atomic uint64_t realloc_events;
+    _Atomic uint64_t metric_recomputations;  // Full recursive, from append/set
+    _Atomic uint64_t metric_refreshes;       // O(children), omega_refresh_metrics
+    _Atomic uint64_t metric_nodes_visited;
+    _Atomic uint64_t key_scans;
+    _Atomic uint64_t key_probes;
+    _Atomic uint64_t key_probe_max;
+    _Atomic uint64_t key_probe_histogram[OMEGA_PROBE_BUCKETS];  // log2 buckets
+    _Atomic uint64_t entry_calls[OMEGA_ENTRY_COUNT];
+    _Atomic uint64_t entry_ticks[OMEGA_ENTRY_COUNT];
+    uint32_t entry_depth[OMEGA_ENTRY_COUNT];  // Owner thread only
+    struct OmegaProfileCounters* next;
+} OmegaProfileCounters;
+
+static _Thread_local OmegaProfileCounters* omega_profile_tls;
+static OmegaProfileCounters* _Atomic omega_profile_threads;
+
+static OmegaProfileCounters* omega_profile_local(void) {
+    OmegaProfileCounters* local = omega_profile_tls;
+    if (!local) {
+        local = calloc(1, sizeof(OmegaProfileCounters));
+        local->next = atomic_load(&omega_profile_threads);
+        while (!atomic_compare_exchange_weak(&omega_profile_threads, &local->next, local)) {}
+        omega_profile_tls = local;
+    }
+    return local;
+}
+
+// Single writer per block: a relaxed load/store pair avoids a locked add
+static inline void omega_profile_add(_Atomic uint64_t* counter, uint64_t amount) {
+    atomic_store_explicit(counter,
+                          atomic_load_explicit(counter, memory_order_relaxed) + amount,
+                          memory_order_relaxed);
+}
+
+static void omega_profile_key_scan(uint64_t probes) {
+    OmegaProfileCounters* local = omega_profile_local();
+    size_t bucket = 0;
+    while (bucket + 1 < OMEGA_PROBE_BUCKETS && (probes >> bucket) > 0) bucket++;
+
+    omega_profile_add(&local->key_scans, 1);
+    omega_profile_add(&local->key_probes, probes);
+    omega_profile_add(&local->key_probe_histogram[bucket], 1);
+    if (probes > atomic_load_explicit(&local->key_probe_max, memory_order_relaxed)) {
+        atomic_store_explicit(&local->key_probe_max, probes, memory_order_relaxed);
+    }
+}
+
+#define OMEGA_PROFILE_ADD(field, amount) \
+    omega_profile_add(&omega_profile_local()->field, (amount))
+#define OMEGA_PROFILE_ALLOC(bytes) \
+    (OMEGA_PROFILE_ADD(allocations, 1), OMEGA_PROFILE_ADD(bytes_allocated, (bytes)))
+#define OMEGA_PROFILE_REALLOC(grown_bytes) \
+    (OMEGA_PROFILE_ADD(realloc_events, 1), OMEGA_PROFILE_ADD(bytes_allocated, (grown_bytes)))
+#define OMEGA_PROFILE_RETYPE(from, to) \
+    (OMEGA_PROFILE_ADD(nodes_created[to], 1), \
+     omega_profile_add(&omega_profile_local()->nodes_created[from], (uint64_t)-1))
+#define OMEGA_PROFILE_KEY_SCAN(probes) omega_profile_key_scan(probes)
+#define OMEGA_PROFILE_ARENA_NODE(arena, type) \
+    (OMEGA_PROFILE_ADD(nodes_created[type], 1), (arena)->nodes[type]++)
+
+#ifdef OMEGA_PROFILE_TIMERS
+
+static inline uint64_t omega_profile_ticks(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+#endif
+}
+
+typedef struct {
+    OmegaProfileEntry entry;
+    uint64_t start;
+} OmegaProfileScope;
+
+// Only the outermost call of an entry point is timed, so recursive entry
+// points (destroy, compact serialization) are not counted twice.
+static inline OmegaProfileScope omega_profile_enter(OmegaProfileEntry entry) {
+    OmegaProfileCounters* local = omega_profile_local();
+    OmegaProfileScope scope = { entry, 0 };
+    if (local->entry_depth[entry]++ == 0) scope.start = omega_profile_ticks();
+    return scope;
+}
+
+static inline void omega_profile_leave(OmegaProfileScope* scope) {
+    OmegaProfileCounters* local = omega_profile_local();
+    if (--local->entry_depth[scope->entry] == 0) {
+        omega_profile_add(&local->entry_calls[scope->entry], 1);
+        omega_profile_add(&local->entry_ticks[scope->entry], omega_profile_ticks() - scope->start);
+    }
+}
+
+#define OMEGA_PROFILE_SCOPE(entry) \
+    __attribute__((cleanup(omega_profile_leave))) OmegaProfileScope omega_profile_scope_ = \
+        omega_profile_enter(entry)
+
+#else
+#define OMEGA_PROFILE_SCOPE(entry) ((void)0)
+#endif
+
+#else
+#define OMEGA_PROFILE_ADD(field, amount) ((void)0)
+#define OMEGA_PROFILE_ALLOC(bytes) ((void)0)
+#define OMEGA_PROFILE_REALLOC(grown_bytes) ((void)0)
+#define OMEGA_PROFILE_RETYPE(from, to) ((void)0)
+#define OMEGA_PROFILE_KEY_SCAN(probes) ((void)0)
+#define OMEGA_PROFILE_ARENA_NODE(arena, type) ((void)0)
+#define OMEGA_PROFILE_SCOPE(entry) ((void)0)
+#endif
+
 // ============================================================================
 // LOSS FUNCTION L(ω) - COMPLEXITY MEASURE
 // ============================================================================
 
 static double calculate_complexity(const OmegaValue* omega) {
     if (!omega) return INFINITY;
+    OMEGA_PROFILE_ADD(metric_nodes_visited, 1);
     
     double L = 0.0;
     
@@ -125,6 +299,7 @@ static double calculate_complexity(const OmegaValue* omega) {
 
 static uint32_t calculate_entropy(const OmegaValue* omega) {
     if (!omega) return 0;
+    OMEGA_PROFILE_ADD(metric_nodes_visited, 1);
     
     uint32_t H = 0;
     
@@ -176,6 +351,7 @@ static uint32_t hash_string(const char* str) {
 
 static uint32_t calculate_symmetry_hash(const OmegaValue* omega) {
     if (!omega) return 0;
+    OMEGA_PROFILE_ADD(metric_nodes_visited, 1);
     
     uint32_t hash = (uint32_t)omega->type * 2654435761U;
     
@@ -218,7 +394,10 @@ static uint32_t calculate_symmetry_hash(const OmegaValue* omega) {
 // ============================================================================
 
 static OmegaValue* omega_create() {
+    OMEGA_PROFILE_SCOPE(OMEGA_ENTRY_CREATE);
     OmegaValue* omega = calloc(1, sizeof(OmegaValue));
+    OMEGA_PROFILE_ALLOC(sizeof(OmegaValue));
+    OMEGA_PROFILE_ADD(nodes_created[OMEGA_NULL], 1);
     omega->type = OMEGA_NULL;
     omega->recursion_depth = 0;
     omega->is_canonical = true;
@@ -226,8 +405,10 @@ static OmegaValue* omega_create() {
 }
 
 static OmegaValue* omega_create_bool(bool value) {
+    OMEGA_PROFILE_SCOPE(OMEGA_ENTRY_CREATE);
     OmegaValue* omega = omega_create();
     omega->type = OMEGA_BOOL;
+    OMEGA_PROFILE_RETYPE(OMEGA_NULL, OMEGA_BOOL);
     omega->data.boolean = value;
     omega->symmetry_hash = calculate_symmetry_hash(omega);
     omega->complexity = calculate_complexity(omega);
@@ -236,8 +417,10 @@ static OmegaValue* omega_create_bool(bool value) {
 }
 
 static OmegaValue* omega_create_number(double value) {
+    OMEGA_PROFILE_SCOPE(OMEGA_ENTRY_CREATE);
     OmegaValue* omega = omega_create();
     omega->type = OMEGA_NUMBER;
+    OMEGA_PROFILE_RETYPE(OMEGA_NULL, OMEGA_NUMBER);
     omega->data.number = value;
     omega->symmetry_hash = calculate_symmetry_hash(omega);
     omega->complexity = calculate_complexity(omega);
@@ -246,9 +429,12 @@ static OmegaValue* omega_create_number(double value) {
 }
 
 static OmegaValue* omega_create_string(const char* value) {
+    OMEGA_PROFILE_SCOPE(OMEGA_ENTRY_CREATE);
     OmegaValue* omega = omega_create();
     omega->type = OMEGA_STRING;
+    OMEGA_PROFILE_RETYPE(OMEGA_NULL, OMEGA_STRING);
     omega->data.string = strdup(value);
+    OMEGA_PROFILE_ALLOC(strlen(value) + 1);
     omega->symmetry_hash = calculate_symmetry_hash(omega);
     omega->complexity = calculate_complexity(omega);
     omega->entropy = calculate_entropy(omega);
@@ -256,20 +442,27 @@ static OmegaValue* omega_create_string(const char* value) {
 }
 
 static OmegaValue* omega_create_array() {
+    OMEGA_PROFILE_SCOPE(OMEGA_ENTRY_CREATE);
     OmegaValue* omega = omega_create();
     omega->type = OMEGA_ARRAY;
+    OMEGA_PROFILE_RETYPE(OMEGA_NULL, OMEGA_ARRAY);
     omega->data.array.capacity = 8;
     omega->data.array.elements = calloc(8, sizeof(OmegaValue*));
+    OMEGA_PROFILE_ALLOC(8 * sizeof(OmegaValue*));
     omega->data.array.count = 0;
     return omega;
 }
 
 static OmegaValue* omega_create_object() {
+    OMEGA_PROFILE_SCOPE(OMEGA_ENTRY_CREATE);
     OmegaValue* omega = omega_create();
     omega->type = OMEGA_OBJECT;
+    OMEGA_PROFILE_RETYPE(OMEGA_NULL, OMEGA_OBJECT);
     omega->data.object = calloc(1, sizeof(OmegaObject));
     omega->data.object->capacity = 8;
     omega->data.object->entries = calloc(8, sizeof(OmegaEntry));
+    OMEGA_PROFILE_ALLOC(sizeof(OmegaObject));
+    OMEGA_PROFILE_ALLOC(8 * sizeof(OmegaEntry));
     omega->data.object->count = 0;
     return omega;
 }
@@ -278,10 +471,22 @@ static OmegaValue* omega_create_object() {
 // RECURSIVE ENCAPSULATION (Ωₙ₊₁ = {Ωₙ})
 // ============================================================================
 
+// Mark omega and every enclosing container as changed since their last
+// canonicalization. A dirty node's ancestors are always dirty, so the walk
+// stops at the first one that already is.
+static void omega_invalidate(OmegaValue* omega) {
+    while (omega && omega->is_canonical) {
+        omega->is_canonical = false;
+        omega = omega->parent;
+    }
+}
+
 static void omega_array_append(OmegaValue* array, OmegaValue* value) {
     if (array->type != OMEGA_ARRAY) return;
+    OMEGA_PROFILE_SCOPE(OMEGA_ENTRY_ARRAY_APPEND);
     
     if (array->data.array.count >= array->data.array.capacity) {
+        OMEGA_PROFILE_REALLOC(array->data.array.capacity * sizeof(OmegaValue*));
         array->data.array.capacity *= 2;
         array->data.array.elements = realloc(
             array->data.array.elements,
@@ -290,12 +495,15 @@ static void omega_array_append(OmegaValue* array, OmegaValue* value) {
     }
     
     array->data.array.elements[array->data.array.count++] = value;
+    omega_invalidate(array);
     
     if (value) {
         value->recursion_depth = array->recursion_depth + 1;
+        value->parent = array;
     }
     
     // Recalculate metrics (gradient flow dynamics)
+    OMEGA_PROFILE_ADD(metric_recomputations, 1);
     array->symmetry_hash = calculate_symmetry_hash(array);
     array->complexity = calculate_complexity(array);
     array->entropy = calculate_entropy(array);
@@ -303,6 +511,7 @@ static void omega_array_append(OmegaValue* array, OmegaValue* value) {
 
 static void omega_object_set(OmegaValue* object, const char* key, OmegaValue* value) {
     if (object->type != OMEGA_OBJECT) return;
+    OMEGA_PROFILE_SCOPE(OMEGA_ENTRY_OBJECT_SET);
     
     uint32_t key_hash = hash_string(key);
     
@@ -310,15 +519,23 @@ static void omega_object_set(OmegaValue* object, const char* key, OmegaValue* va
     for (size_t i = 0; i < object->data.object->count; i++) {
         if (object->data.object->entries[i].key_hash == key_hash &&
             strcmp(object->data.object->entries[i].key, key) == 0) {
+            OMEGA_PROFILE_KEY_SCAN(i + 1);
             // Replace existing value
             object->data.object->entries[i].value = value;
-            if (value) value->recursion_depth = object->recursion_depth + 1;
+            omega_invalidate(object);
+            if (value) {
+                value->recursion_depth = object->recursion_depth + 1;
+                value->parent = object;
+            }
             return;
         }
     }
     
+    OMEGA_PROFILE_KEY_SCAN(object->data.object->count);
+    
     // Add new entry
     if (object->data.object->count >= object->data.object->capacity) {
+        OMEGA_PROFILE_REALLOC(object->data.object->capacity * sizeof(OmegaEntry));
         object->data.object->capacity *= 2;
         object->data.object->entries = realloc(
             object->data.object->entries,
@@ -328,19 +545,40 @@ static void omega_object_set(OmegaValue* object, const char* key, OmegaValue* va
     
     OmegaEntry* entry = &object->data.object->entries[object->data.object->count++];
     entry->key = strdup(key);
+    OMEGA_PROFILE_ALLOC(strlen(key) + 1);
     entry->key_hash = key_hash;
     entry->value = value;
+    omega_invalidate(object);
     
     if (value) {
         value->recursion_depth = object->recursion_depth + 1;
+        value->parent = object;
     }
     
     // Recalculate metrics
+    OMEGA_PROFILE_ADD(metric_recomputations, 1);
     object->symmetry_hash = calculate_symmetry_hash(object);
     object->complexity = calculate_complexity(object);
     object->entropy = calculate_entropy(object);
 }
 
+static OmegaValue* omega_object_get(const OmegaValue* object, const char* key) {
+    if (!object || object->type != OMEGA_OBJECT) return NULL;
+    OMEGA_PROFILE_SCOPE(OMEGA_ENTRY_OBJECT_GET);
+    
+    uint32_t key_hash = hash_string(key);
+    
+    for (size_t i = 0; i < object->data.object->count; i++) {
+        if (object->data.object->entries[i].key_hash == key_hash &&
+            strcmp(object->data.object->entries[i].key, key) == 0) {
+            OMEGA_PROFILE_KEY_SCAN(i + 1);
+            return object->data.object->entries[i].value;
+        }
+    }
+    OMEGA_PROFILE_KEY_SCAN(object->data.object->count);
+    return NULL;
+}
+
 // ============================================================================
 // SERIALIZATION (Ω → String Representation)
 // ============================================================================
@@ -398,6 +636,7 @@ static void omega_serialize_internal(const OmegaValue* omega, FILE* out, int ind
 }
 
 static void omega_serialize(const OmegaValue* omega, FILE* out) {
+    OMEGA_PROFILE_SCOPE(OMEGA_ENTRY_SERIALIZE);
     omega_serialize_internal(omega, out, 0);
     fprintf(out, "\n");
 }
@@ -408,6 +647,8 @@ static void omega_serialize(const OmegaValue* omega, FILE* out) {
 
 static void omega_destroy(OmegaValue* omega) {
     if (!omega) return;
+    OMEGA_PROFILE_SCOPE(OMEGA_ENTRY_DESTROY);
+    OMEGA_PROFILE_ADD(nodes_destroyed[omega->type], 1);
     
     switch (omega->type) {
         case OMEGA_STRING:
@@ -438,67 +679,1842 @@ static void omega_destroy(OmegaValue* omega) {
 }
 
 // ============================================================================
-// DEMONSTRATION & TEST
+// METRIC REFRESH (∂L/∂ω - local gradient step)
 // ============================================================================
 
-int main(void) {
-    printf("=== OmegaJSON: Reflectological Data Format ===\n\n");
-    
-    // Ω₀ = ∅ (null configuration)
-    printf("Stage 1 - Ω₀ (empty configuration):\n");
-    OmegaValue* omega0 = omega_create();
-    omega_serialize(omega0, stdout);
-    printf("Complexity L(ω₀) = %.2f\n", omega0->complexity);
-    printf("Entropy H(ω₀) = %u\n\n", omega0->entropy);
-    
-    // Ω₁ = {∅} (singleton encapsulation)
-    printf("Stage 2 - Ω₁ (primitive structures):\n");
-    OmegaValue* omega1 = omega_create_object();
-    omega_object_set(omega1, "empty", omega0);
-    omega_object_set(omega1, "truth", omega_create_bool(true));
-    omega_object_set(omega1, "number", omega_create_number(42.0));
-    omega_object_set(omega1, "string", omega_create_string("Omega"));
-    omega_serialize(omega1, stdout);
-    printf("Complexity L(ω₁) = %.2f\n", omega1->complexity);
-    printf("Entropy H(ω₁) = %u\n", omega1->entropy);
-    printf("Symmetry Hash: 0x%08X\n\n", omega1->symmetry_hash);
-    
-    // Ω₂ (recursive encapsulation)
-    printf("Stage 3 - Ω₂ (recursive structures):\n");
-    OmegaValue* omega2 = omega_create_object();
-    
-    OmegaValue* nested_array = omega_create_array();
-    omega_array_append(nested_array, omega_create_number(1.0));
-    omega_array_append(nested_array, omega_create_number(2.0));
-    omega_array_append(nested_array, omega_create_number(3.0));
-    
-    OmegaValue* nested_object = omega_create_object();
-    omega_object_set(nested_object, "reflective", omega_create_bool(true));
-    omega_object_set(nested_object, "convergence", omega_create_string("stable"));
-    
-    omega_object_set(omega2, "array", nested_array);
-    omega_object_set(omega2, "nested", nested_object);
-    omega_object_set(omega2, "previous", omega1);
-    
-    omega_serialize(omega2, stdout);
-    printf("Complexity L(ω₂) = %.2f\n", omega2->complexity);
-    printf("Entropy H(ω₂) = %u\n", omega2->entropy);
-    printf("Recursion Depth: %u\n\n", omega2->recursion_depth);
-    
-    // Demonstrate symmetry detection
-    printf("Stage 4 - Symmetry Analysis (Ω/G):\n");
-    OmegaValue* sym1 = omega_create_array();
-    omega_array_append(sym1, omega_create_number(1.0));
-    omega_array_append(sym1, omega_create_number(2.0));
-    
-    OmegaValue* sym2 = omega_create_array();
-    omega_array_append(sym2, omega_create_number(1.0));
-    omega_array_append(sym2, omega_create_number(2.0));
-    
-    printf("Array 1 hash: 0x%08X\n", sym1->symmetry_hash);
-    printf("Array 2 hash: 0x%08X\n", sym2->symmetry_hash);
-    printf("Symmetric: %s\n\n", 
-           sym1->symmetry_hash == sym2->symmetry_hash ? "YES (Ω/~)" : "NO");
+// Recompute one node's metrics from its children's cached metrics.
+// Yields the same values as the recursive calculators whenever the
+// children are up to date, but costs O(children) instead of O(subtree).
+static void omega_refresh_metrics(OmegaValue* omega) {
+    OMEGA_PROFILE_ADD(metric_refreshes, 1);
+    switch (omega->type) {
+        case OMEGA_ARRAY: {
+            size_t count = omega->data.array.count;
+            uint32_t hash = (uint32_t)OMEGA_ARRAY * 2654435761U;
+            double L = count;
+            uint32_t H = count;
+            for (size_t i = 0; i < count; i++) {
+                const OmegaValue* child = omega->data.array.elements[i];
+                hash ^= (child ? child->symmetry_hash : 0) * (i + 1);
+                L += (child ? child->complexity : INFINITY) * 0.8;
+                H += child ? child->entropy : 0;
+            }
+            omega->symmetry_hash = hash;
+            omega->complexity = L;
+            omega->entropy = H;
+            break;
+        }
+        case OMEGA_OBJECT: {
+            const OmegaObject* object = omega->data.object;
+            uint32_t hash = (uint32_t)OMEGA_OBJECT * 2654435761U;
+            double L = object->count * 1.5;
+            uint32_t H = object->count * 2;
+            for (size_t i = 0; i < object->count; i++) {
+                const OmegaValue* child = object->entries[i].value;
+                hash ^= object->entries[i].key_hash;
+                hash ^= child ? child->symmetry_hash : 0;
+                L += (child ? child->complexity : INFINITY) * 0.9;
+                H += child ? child->entropy : 0;
+            }
+            omega->symmetry_hash = hash;
+            omega->complexity = L;
+            omega->entropy = H;
+            break;
+        }
+        default:
+            omega->symmetry_hash = calculate_symmetry_hash(omega);
+            omega->complexity = calculate_complexity(omega);
+            omega->entropy = calculate_entropy(omega);
+            break;
+    }
+}
+
+// ============================================================================
+// CANONICALIZATION (ω* = argmin_{ω ∈ Ω} L(ω))
+// ============================================================================
+
+/*
+ * Each class of Ω/~ is represented by one interned OmegaCanon node:
+ * - Ω/G: object entries are ordered by key (the key-permutation group)
+ * - numbers are normalized (-0 → 0, non-finite → ∅)
+ * - equal subtrees share a single representative (hash-consing)
+ *
+ * Every node remembers its representative and the cache epoch it belongs
+ * to. append/set mark the touched container and all of its ancestors
+ * dirty, so a subtree left untouched since the last pass against the same
+ * cache returns its memoized ω* in O(1) without being descended; only the
+ * dirty spine and the new values are re-sorted and re-interned. Against a
+ * different cache, nodes still reuse their canonical_hash instead of
+ * rehashing their content.
+ *
+ * A cache only grows during a pass. Once it holds more than max_nodes
+ * representatives (OMEGA_CANON_CACHE_MAX_NODES by default, 0 = unbounded)
+ * it is emptied at the start of the next omega_canonicalize, which starts a
+ * new epoch; trees then rebuild their memos against the fresh cache.
+ * Pointers returned by earlier passes are invalid after a reset.
+ */
+
+#ifndef OMEGA_CANON_CACHE_MAX_NODES
+#define OMEGA_CANON_CACHE_MAX_NODES (1u << 20)
+#endif
+
+struct OmegaCanon {
+    uint64_t hash;
+    OmegaType type;
+    union {
+        bool boolean;
+        double number;
+        char* string;
+        size_t reference_id;
+    } leaf;
+    size_t count;
+    const OmegaCanon** children;
+    char** keys;      // Objects only, in canonical order
+    OmegaCanon* next; // Bucket chain
+};
+
+typedef struct {
+    OmegaCanon** buckets;
+    size_t bucket_count;
+    size_t count;
+    size_t max_nodes;     // Reset threshold, checked between passes
+    uint64_t epoch;       // Unique per cache and reset; older memos are ignored
+    size_t memo_hits;     // Subtrees reused from a previous pass
+    size_t intern_hits;   // Rebuilt subtrees that matched an existing ω*
+    size_t resets;
+} OmegaCanonCache;
+
+static _Atomic uint64_t canon_epoch_counter;
+
+static uint64_t canon_mix(uint64_t hash, uint64_t value) {
+    hash ^= value + 0x9E3779B97F4A7C15ULL + (hash << 6) + (hash >> 2);
+    hash ^= hash >> 33;
+    hash *= 0xFF51AFD7ED558CCDULL;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+static uint64_t canon_hash_string(const char* str) {
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    while (*str) {
+        hash ^= (unsigned char)*str++;
+        hash *= 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+static uint64_t canon_hash_node(const OmegaCanon* node) {
+    uint64_t hash = canon_mix(0, (uint64_t)node->type + 1);
+
+    switch (node->type) {
+        case OMEGA_BOOL:
+            hash = canon_mix(hash, node->leaf.boolean);
+            break;
+        case OMEGA_NUMBER: {
+            uint64_t bits;
+            memcpy(&bits, &node->leaf.number, sizeof(double));
+            hash = canon_mix(hash, bits);
+            break;
+        }
+        case OMEGA_STRING:
+            hash = canon_mix(hash, canon_hash_string(node->leaf.string));
+            break;
+        case OMEGA_REFERENCE:
+            hash = canon_mix(hash, node->leaf.reference_id);
+            break;
+        case OMEGA_ARRAY:
+        case OMEGA_OBJECT:
+            hash = canon_mix(hash, node->count);
+            for (size_t i = 0; i < node->count; i++) {
+                if (node->keys) hash = canon_mix(hash, canon_hash_string(node->keys[i]));
+                hash = canon_mix(hash, node->children[i]->hash);
+            }
+            break;
+        default:
+            break;
+    }
+
+    return hash ? hash : 1;  // 0 is reserved for "not canonicalized"
+}
+
+// Structural equality; children are compared by identity since they are
+// already interned.
+static bool canon_equal(const OmegaCanon* a, const OmegaCanon* b) {
+    if (a->hash != b->hash || a->type != b->type || a->count != b->count) return false;
+
+    switch (a->type) {
+        case OMEGA_BOOL:
+            return a->leaf.boolean == b->leaf.boolean;
+        case OMEGA_NUMBER:
+            return memcmp(&a->leaf.number, &b->leaf.number, sizeof(double)) == 0;
+        case OMEGA_STRING:
+            return strcmp(a->leaf.string, b->leaf.string) == 0;
+        case OMEGA_REFERENCE:
+            return a->leaf.reference_id == b->leaf.reference_id;
+        case OMEGA_ARRAY:
+        case OMEGA_OBJECT:
+            for (size_t i = 0; i < a->count; i++) {
+                if (a->children[i] != b->children[i]) return false;
+                if (a->keys && strcmp(a->keys[i], b->keys[i]) != 0) return false;
+            }
+            return true;
+        default:
+            return true;
+    }
+}
+
+static OmegaCanonCache* omega_canon_cache_create(void) {
+    OmegaCanonCache* cache = calloc(1, sizeof(OmegaCanonCache));
+    cache->epoch = atomic_fetch_add(&canon_epoch_counter, 1) + 1;
+    cache->max_nodes = OMEGA_CANON_CACHE_MAX_NODES;
+    cache->bucket_count = 64;
+    cache->buckets = calloc(cache->bucket_count, sizeof(OmegaCanon*));
+    OMEGA_PROFILE_ALLOC(sizeof(OmegaCanonCache));
+    OMEGA_PROFILE_ALLOC(cache->bucket_count * sizeof(OmegaCanon*));
+    return cache;
+}
+
+static void canon_cache_free_nodes(OmegaCanonCache* cache) {
+    for (size_t b = 0; b < cache->bucket_count; b++) {
+        OmegaCanon* node = cache->buckets[b];
+        while (node) {
+            OmegaCanon* next = node->next;
+            if (node->type == OMEGA_STRING) free(node->leaf.string);
+            if (node->keys) {
+                for (size_t i = 0; i < node->count; i++) free(node->keys[i]);
+                free(node->keys);
+            }
+            free(node->children);
+            free(node);
+            node = next;
+        }
+    }
+}
+
+static void omega_canon_cache_destroy(OmegaCanonCache* cache) {
+    if (!cache) return;
+    canon_cache_free_nodes(cache);
+    free(cache->buckets);
+    free(cache);
+}
+
+// Drop every representative and start a new epoch. Trees keep their
+// canonical_hash, so the next pass re-interns without rehashing.
+static void omega_canon_cache_reset(OmegaCanonCache* cache) {
+    canon_cache_free_nodes(cache);
+    free(cache->buckets);
+    cache->bucket_count = 64;
+    cache->buckets = calloc(cache->bucket_count, sizeof(OmegaCanon*));
+    OMEGA_PROFILE_ALLOC(cache->bucket_count * sizeof(OmegaCanon*));
+    cache->count = 0;
+    cache->epoch = atomic_fetch_add(&canon_epoch_counter, 1) + 1;
+    cache->resets++;
+}
+
+static void canon_cache_grow(OmegaCanonCache* cache) {
+    size_t bucket_count = cache->bucket_count * 2;
+    OmegaCanon** buckets = calloc(bucket_count, sizeof(OmegaCanon*));
+    OMEGA_PROFILE_ALLOC(bucket_count * sizeof(OmegaCanon*));
+
+    for (size_t b = 0; b < cache->bucket_count; b++) {
+        OmegaCanon* node = cache->buckets[b];
+        while (node) {
+            OmegaCanon* next = node->next;
+            size_t slot = node->hash & (bucket_count - 1);
+            node->next = buckets[slot];
+            buckets[slot] = node;
+            node = next;
+        }
+    }
+
+    free(cache->buckets);
+    cache->buckets = buckets;
+    cache->bucket_count = bucket_count;
+}
+
+// Return the representative equal to probe, copying probe in if it is new.
+// A non-zero probe->hash is trusted as the node's hash.
+static const OmegaCanon* canon_intern(OmegaCanonCache* cache, OmegaCanon* probe) {
+    if (!probe->hash) probe->hash = canon_hash_node(probe);
+
+    for (OmegaCanon* node = cache->buckets[probe->hash & (cache->bucket_count - 1)];
+         node; node = node->next) {
+        if (canon_equal(node, probe)) {
+            cache->intern_hits++;
+            return node;
+        }
+    }
+
+    if (cache->count + 1 > cache->bucket_count - cache->bucket_count / 4) {
+        canon_cache_grow(cache);
+    }
+
+    OmegaCanon* node = malloc(sizeof(OmegaCanon));
+    OMEGA_PROFILE_ALLOC(sizeof(OmegaCanon));
+    *node = *probe;
+    if (probe->type == OMEGA_STRING) {
+        node->leaf.string = strdup(probe->leaf.string);
+        OMEGA_PROFILE_ALLOC(strlen(probe->leaf.string) + 1);
+    }
+    if (probe->count > 0) {
+        node->children = malloc(probe->count * sizeof(OmegaCanon*));
+        OMEGA_PROFILE_ALLOC(probe->count * sizeof(OmegaCanon*));
+        memcpy(node->children, probe->children, probe->count * sizeof(OmegaCanon*));
+    } else {
+        node->children = NULL;
+    }
+    if (probe->keys) {
+        node->keys = malloc((probe->count ? probe->count : 1) * sizeof(char*));
+        OMEGA_PROFILE_ALLOC((probe->count ? probe->count : 1) * sizeof(char*));
+        for (size_t i = 0; i < probe->count; i++) {
+            node->keys[i] = strdup(probe->keys[i]);
+            OMEGA_PROFILE_ALLOC(strlen(probe->keys[i]) + 1);
+        }
+    }
+
+    size_t slot = node->hash & (cache->bucket_count - 1);
+    node->next = cache->buckets[slot];
+    cache->buckets[slot] = node;
+    cache->count++;
+    return node;
+}
+
+// Find the representative a container was given on a previous pass.
+static const OmegaCanon* canon_lookup(const OmegaCanonCache* cache, uint64_t hash,
+                                      OmegaType type, size_t count) {
+    for (const OmegaCanon* node = cache->buckets[hash & (cache->bucket_count - 1)];
+         node; node = node->next) {
+        if (node->hash == hash && node->type == type && node->count == count) return node;
+    }
+    return NULL;
+}
+
+static int canon_compare_entries(const void* a, const void* b) {
+    return strcmp(((const OmegaEntry*)a)->key, ((const OmegaEntry*)b)->key);
+}
+
+static void canon_sort_entries(OmegaObject* object) {
+    for (size_t i = 1; i < object->count; i++) {
+        if (strcmp(object->entries[i - 1].key, object->entries[i].key) > 0) {
+            qsort(object->entries, object->count, sizeof(OmegaEntry), canon_compare_entries);
+            return;
+        }
+    }
+}
+
+static const OmegaCanon* canon_visit(OmegaValue* omega, OmegaCanonCache* cache);
+
+static const OmegaCanon* canon_remember(OmegaValue* omega, const OmegaCanonCache* cache,
+                                       const OmegaCanon* canon) {
+    omega->canonical_hash = canon->hash;
+    omega->canonical = canon;
+    omega->canonical_epoch = cache->epoch;
+    omega->is_canonical = true;
+    return canon;
+}
+
+static const OmegaCanon* canon_visit_leaf(OmegaValue* omega, OmegaCanonCache* cache) {
+    OmegaCanon probe = { .type = omega ? omega->type : OMEGA_NULL };
+
+    if (!omega) return canon_intern(cache, &probe);
+
+    // Already normalized on an earlier pass: only the hash is reused
+    if (omega->is_canonical && omega->canonical_hash) probe.hash = omega->canonical_hash;
+
+    switch (omega->type) {
+        case OMEGA_BOOL:
+            probe.leaf.boolean = omega->data.boolean;
+            break;
+        case OMEGA_NUMBER:
+            if (!isfinite(omega->data.number)) {
+                // No JSON spelling exists for NaN/∞; they collapse to ∅
+                omega->type = OMEGA_NULL;
+                OMEGA_PROFILE_RETYPE(OMEGA_NUMBER, OMEGA_NULL);
+                omega_refresh_metrics(omega);
+                probe.type = OMEGA_NULL;
+            } else if (omega->data.number == 0.0 && signbit(omega->data.number)) {
+                omega->data.number = 0.0;
+                omega_refresh_metrics(omega);
+            }
+            probe.leaf.number = omega->type == OMEGA_NUMBER ? omega->data.number : 0.0;
+            break;
+        case OMEGA_STRING:
+            probe.leaf.string = omega->data.string;
+            break;
+        case OMEGA_REFERENCE:
+            probe.leaf.reference_id = omega->data.reference_id;
+            break;
+        default:
+            break;
+    }
+
+    return canon_remember(omega, cache, canon_intern(cache, &probe));
+}
+
+static const OmegaCanon* canon_visit_container(OmegaValue* omega, OmegaCanonCache* cache) {
+    bool is_object = omega->type == OMEGA_OBJECT;
+    size_t count = is_object ? omega->data.object->count : omega->data.array.count;
+    bool untouched = omega->is_canonical && omega->canonical_hash != 0;
+
+    // Keys only need sorting if set() ran since the last pass
+    if (is_object && !untouched) canon_sort_entries(omega->data.object);
+
+    const OmegaCanon* memo = untouched
+        ? canon_lookup(cache, omega->canonical_hash, omega->type, count) : NULL;
+
+    const OmegaCanon* local_children[32];
+    char* local_keys[32];
+    const OmegaCanon** children = count <= 32
+        ? local_children : malloc(count * sizeof(OmegaCanon*));
+    char** keys = !is_object ? NULL
+        : count <= 32 ? local_keys : malloc(count * sizeof(char*));
+    if (count > 32) OMEGA_PROFILE_ALLOC(count * (is_object ? 2 : 1) * sizeof(void*));
+
+    for (size_t i = 0; i < count; i++) {
+        OmegaValue* child = is_object
+            ? omega->data.object->entries[i].value : omega->data.array.elements[i];
+        children[i] = canon_visit(child, cache);
+        if (is_object) keys[i] = omega->data.object->entries[i].key;
+
+        if (memo && (children[i] != memo->children[i] ||
+                     (is_object && strcmp(keys[i], memo->keys[i]) != 0))) {
+            memo = NULL;
+        }
+    }
+
+    const OmegaCanon* canon = memo;
+    if (canon) {
+        cache->memo_hits++;
+    } else {
+        OmegaCanon probe = {
+            .hash = untouched ? omega->canonical_hash : 0,
+            .type = omega->type,
+            .count = count,
+            .children = children,
+            .keys = keys
+        };
+        canon = canon_intern(cache, &probe);
+        omega_refresh_metrics(omega);
+    }
+
+    if (children != local_children) free(children);
+    if (keys && keys != local_keys) free(keys);
+
+    return canon_remember(omega, cache, canon);
+}
+
+static const OmegaCanon* canon_visit(OmegaValue* omega, OmegaCanonCache* cache) {
+    // Untouched since the last pass against this cache: O(1)
+    if (omega && omega->is_canonical && omega->canonical &&
+        omega->canonical_epoch == cache->epoch) {
+        cache->memo_hits++;
+        return omega->canonical;
+    }
+    if (omega && (omega->type == OMEGA_ARRAY || omega->type == OMEGA_OBJECT)) {
+        return canon_visit_container(omega, cache);
+    }
+    return canon_visit_leaf(omega, cache);
+}
+
+// Rewrite omega in place into its canonical representative ω* and return
+// the interned class it belongs to. Equal documents canonicalized against
+// the same cache (within one epoch) return the same pointer.
+static const OmegaCanon* omega_canonicalize(OmegaValue* omega, OmegaCanonCache* cache) {
+    OMEGA_PROFILE_SCOPE(OMEGA_ENTRY_CANONICALIZE);
+    if (cache->max_nodes && cache->count > cache->max_nodes) omega_canon_cache_reset(cache);
+    return canon_visit(omega, cache);
+}
+
+// ============================================================================
+// CANONICAL SERIALIZATION (ω* → bytes, memcmp-comparable)
+// ============================================================================
+
+typedef struct {
+    char* data;
+    size_t length;
+    size_t capacity;
+} OmegaBuffer;
+
+static void buffer_append(OmegaBuffer* buffer, const char* bytes, size_t length) {
+    if (buffer->length + length + 1 > buffer->capacity) {
+        size_t capacity = buffer->capacity ? buffer->capacity : 64;
+        while (buffer->length + length + 1 > capacity) capacity *= 2;
+        if (buffer->data) OMEGA_PROFILE_REALLOC(capacity - buffer->capacity);
+        else OMEGA_PROFILE_ALLOC(capacity);
+        buffer->data = realloc(buffer->data, capacity);
+        buffer->capacity = capacity;
+    }
+    memcpy(buffer->data + buffer->length, bytes, length);
+    buffer->length += length;
+    buffer->data[buffer->length] = '\0';
+}
+
+static void buffer_append_string(OmegaBuffer* buffer, const char* str) {
+    static const char hex[] = "0123456789abcdef";
+    const char* run = str;
+
+    buffer_append(buffer, "\"", 1);
+    for (const unsigned char* p = (const unsigned char*)str; *p; p++) {
+        const char* escape = NULL;
+        char unicode[7];
+
+        switch (*p) {
+            case '"':  escape = "\\\""; break;
+            case '\\': escape = "\\\\"; break;
+            case '\b': escape = "\\b"; break;
+            case '\f': escape = "\\f"; break;
+            case '\n': escape = "\\n"; break;
+            case '\r': escape = "\\r"; break;
+            case '\t': escape = "\\t"; break;
+            default:
+                if (*p < 0x20) {
+                    memcpy(unicode, "\\u00", 4);
+                    unicode[4] = hex[*p >> 4];
+                    unicode[5] = hex[*p & 0xF];
+                    unicode[6] = '\0';
+                    escape = unicode;
+                }
+                break;
+        }
+
+        if (escape) {
+            buffer_append(buffer, run, (const char*)p - run);
+            buffer_append(buffer, escape, strlen(escape));
+            run = (const char*)p + 1;
+        }
+    }
+    buffer_append(buffer, run, strlen(run));
+    buffer_append(buffer, "\"", 1);
+}
+
+// Integers in the exactly representable range print without exponent,
+// everything else uses the shortest %g form that round-trips.
+static void buffer_append_number(OmegaBuffer* buffer, double number) {
+    char text[32];
+
+    if (floor(number) == number && fabs(number) < 9007199254740992.0) {
+        // Integral: emit digits directly, far cheaper than printf("%.0f")
+        uint64_t magnitude = (uint64_t)fabs(number);
+        char* p = text + sizeof(text);
+        *--p = '\0';
+        do {
+            *--p = (char)('0' + magnitude % 10);
+            magnitude /= 10;
+        } while (magnitude);
+        if (number < 0) *--p = '-';
+        buffer_append(buffer, p, text + sizeof(text) - 1 - p);
+        return;
+    } else {
+        for (int precision = 15; precision <= 17; precision++) {
+            snprintf(text, sizeof(text), "%.*g", precision, number);
+            if (strtod(text, NULL) == number) break;
+        }
+    }
+    buffer_append(buffer, text, strlen(text));
+}
+
+static void canon_serialize_internal(const OmegaCanon* canon, OmegaBuffer* buffer) {
+    switch (canon->type) {
+        case OMEGA_NULL:
+            buffer_append(buffer, "null", 4);
+            break;
+        case OMEGA_BOOL:
+            if (canon->leaf.boolean) buffer_append(buffer, "true", 4);
+            else buffer_append(buffer, "false", 5);
+            break;
+        case OMEGA_NUMBER:
+            buffer_append_number(buffer, canon->leaf.number);
+            break;
+        case OMEGA_STRING:
+            buffer_append_string(buffer, canon->leaf.string);
+            break;
+        case OMEGA_ARRAY:
+            buffer_append(buffer, "[", 1);
+            for (size_t i = 0; i < canon->count; i++) {
+                if (i > 0) buffer_append(buffer, ",", 1);
+                canon_serialize_internal(canon->children[i], buffer);
+            }
+            buffer_append(buffer, "]", 1);
+            break;
+        case OMEGA_OBJECT:
+            buffer_append(buffer, "{", 1);
+            for (size_t i = 0; i < canon->count; i++) {
+                if (i > 0) buffer_append(buffer, ",", 1);
+                buffer_append_string(buffer, canon->keys[i]);
+                buffer_append(buffer, ":", 1);
+                canon_serialize_internal(canon->children[i], buffer);
+            }
+            buffer_append(buffer, "}", 1);
+            break;
+        case OMEGA_REFERENCE: {
+            char text[32];
+            snprintf(text, sizeof(text), "@ref:%zu", canon->leaf.reference_id);
+            buffer_append(buffer, text, strlen(text));
+            break;
+        }
+    }
+}
+
+// Canonicalize omega and return its compact canonical encoding (caller
+// frees). Two documents are Ω/~-equivalent iff the bytes are identical.
+static char* omega_serialize_canonical(OmegaValue* omega, OmegaCanonCache* cache,
+                                       size_t* length) {
+    OMEGA_PROFILE_SCOPE(OMEGA_ENTRY_SERIALIZE_CANONICAL);
+    OmegaBuffer buffer = {0};
+    canon_serialize_internal(omega_canonicalize(omega, cache), &buffer);
+    if (!buffer.data) buffer_append(&buffer, "", 0);
+    if (length) *length = buffer.length;
+    return buffer.data;
+}
+
+// Append omega as compact, escaped JSON in its current (not canonical) order.
+static void omega_serialize_compact(const OmegaValue* omega, OmegaBuffer* buffer) {
+    OMEGA_PROFILE_SCOPE(OMEGA_ENTRY_SERIALIZE_COMPACT);
+    if (!omega) {
+        buffer_append(buffer, "null", 4);
+        return;
+    }
+
+    switch (omega->type) {
+        case OMEGA_NULL:
+            buffer_append(buffer, "null", 4);
+            break;
+        case OMEGA_BOOL:
+            if (omega->data.boolean) buffer_append(buffer, "true", 4);
+            else buffer_append(buffer, "false", 5);
+            break;
+        case OMEGA_NUMBER:
+            if (isfinite(omega->data.number)) buffer_append_number(buffer, omega->data.number);
+            else buffer_append(buffer, "null", 4);
+            break;
+        case OMEGA_STRING:
+            buffer_append_string(buffer, omega->data.string);
+            break;
+        case OMEGA_ARRAY:
+            buffer_append(buffer, "[", 1);
+            for (size_t i = 0; i < omega->data.array.count; i++) {
+                if (i > 0) buffer_append(buffer, ",", 1);
+                omega_serialize_compact(omega->data.array.elements[i], buffer);
+            }
+            buffer_append(buffer, "]", 1);
+            break;
+        case OMEGA_OBJECT:
+            buffer_append(buffer, "{", 1);
+            for (size_t i = 0; i < omega->data.object->count; i++) {
+                if (i > 0) buffer_append(buffer, ",", 1);
+                buffer_append_string(buffer, omega->data.object->entries[i].key);
+                buffer_append(buffer, ":", 1);
+                omega_serialize_compact(omega->data.object->entries[i].value, buffer);
+            }
+            buffer_append(buffer, "}", 1);
+            break;
+        case OMEGA_REFERENCE: {
+            char text[32];
+            snprintf(text, sizeof(text), "@ref:%zu", omega->data.reference_id);
+            buffer_append(buffer, text, strlen(text));
+            break;
+        }
+    }
+}
+
+// ============================================================================
+// ARENA ALLOCATION (bulk lifetime for parsed Ω)
+// ============================================================================
+
+/*
+ * A bump allocator for trees that live and die together, such as one
+ * record in a streaming pipeline. omega_parse_arena() places every node,
+ * string, key and child array of the tree in the arena; omega_arena_reset()
+ * releases them all at once and keeps the chunks for the next tree.
+ *
+ * Arena trees are read-only apart from canonicalization: never pass them
+ * to omega_destroy, omega_array_append or omega_object_set.
+ */
+
+#define OMEGA_ARENA_CHUNK (64 * 1024)
+
+typedef struct OmegaArenaChunk {
+    struct OmegaArenaChunk* next;
+    size_t capacity;
+    size_t used;
+    _Alignas(16) char data[];
+} OmegaArenaChunk;
+
+typedef struct {
+    OmegaArenaChunk* first;
+    OmegaArenaChunk* current;
+    size_t chunk_size;
+#ifdef OMEGA_PROFILE
+    uint64_t nodes[OMEGA_TYPE_COUNT];  // Nodes per type since the last reset
+#endif
+} OmegaArena;
+
+static OmegaArena* omega_arena_create(size_t chunk_size) {
+    OmegaArena* arena = calloc(1, sizeof(OmegaArena));
+    OMEGA_PROFILE_ALLOC(sizeof(OmegaArena));
+    arena->chunk_size = chunk_size ? chunk_size : OMEGA_ARENA_CHUNK;
+    return arena;
+}
+
+// Zeroed, 16-byte aligned storage that lives until the next reset
+static void* omega_arena_alloc(OmegaArena* arena, size_t size) {
+    size = (size + 15) & ~(size_t)15;
+
+    OmegaArenaChunk* chunk = arena->current;
+    if (!chunk || chunk->used + size > chunk->capacity) {
+        // Reuse the next retained chunk if it fits, else insert a new one
+        OmegaArenaChunk* next = chunk ? chunk->next : arena->first;
+        if (next && size <= next->capacity) {
+            chunk = next;
+        } else {
+            size_t capacity = size > arena->chunk_size ? size : arena->chunk_size;
+            chunk = malloc(sizeof(OmegaArenaChunk) + capacity);
+            OMEGA_PROFILE_ALLOC(sizeof(OmegaArenaChunk) + capacity);
+            chunk->capacity = capacity;
+            chunk->next = next;
+            if (arena->current) arena->current->next = chunk;
+            else arena->first = chunk;
+        }
+        chunk->used = 0;
+        arena->current = chunk;
+    }
+
+    void* memory = chunk->data + chunk->used;
+    chunk->used += size;
+    memset(memory, 0, size);
+    return memory;
+}
+
+// Arena nodes die in bulk, so their destruction is counted here
+static void arena_profile_release(OmegaArena* arena) {
+#ifdef OMEGA_PROFILE
+    for (int t = 0; t < OMEGA_TYPE_COUNT; t++) {
+        OMEGA_PROFILE_ADD(nodes_destroyed[t], arena->nodes[t]);
+        arena->nodes[t] = 0;
+    }
+#else
+    (void)arena;
+#endif
+}
+
+static void omega_arena_reset(OmegaArena* arena) {
+    arena_profile_release(arena);
+    arena->current = NULL;
+}
+
+static void omega_arena_destroy(OmegaArena* arena) {
+    if (!arena) return;
+    arena_profile_release(arena);
+    for (OmegaArenaChunk* chunk = arena->first; chunk;) {
+        OmegaArenaChunk* next = chunk->next;
+        free(chunk);
+        chunk = next;
+    }
+    free(arena);
+}
+
+// ============================================================================
+// PARSING (String → Ω)
+// ============================================================================
+
+#define OMEGA_MAX_DEPTH 1024
+
+typedef struct {
+    const char* cursor;
+    const char* end;
+    OmegaArena* arena;    // NULL: nodes come from the heap
+    OmegaBuffer scratch;  // String decoding space, arena parses only
+} OmegaParser;
+
+// New node of the given type; containers start with room for 8 children.
+static OmegaValue* parser_create(OmegaParser* parser, OmegaType type) {
+    if (!parser->arena) {
+        if (type == OMEGA_ARRAY) return omega_create_array();
+        if (type == OMEGA_OBJECT) return omega_create_object();
+        OmegaValue* omega = omega_create();
+        omega->type = type;
+        OMEGA_PROFILE_RETYPE(OMEGA_NULL, type);
+        return omega;
+    }
+
+    OmegaValue* omega = omega_arena_alloc(parser->arena, sizeof(OmegaValue));
+    OMEGA_PROFILE_ARENA_NODE(parser->arena, type);
+    omega->type = type;
+    omega->is_canonical = true;
+    if (type == OMEGA_ARRAY) {
+        omega->data.array.capacity = 8;
+        omega->data.array.elements = omega_arena_alloc(parser->arena, 8 * sizeof(OmegaValue*));
+    } else if (type == OMEGA_OBJECT) {
+        omega->data.object = omega_arena_alloc(parser->arena, sizeof(OmegaObject));
+        omega->data.object->capacity = 8;
+        omega->data.object->entries = omega_arena_alloc(parser->arena, 8 * sizeof(OmegaEntry));
+    }
+    return omega;
+}
+
+// Grow a child array to twice its capacity
+static void* parser_grow(OmegaParser* parser, void* items, size_t capacity, size_t size) {
+    if (!parser->arena) {
+        OMEGA_PROFILE_REALLOC(capacity * size);
+        return realloc(items, capacity * 2 * size);
+    }
+    void* grown = omega_arena_alloc(parser->arena, capacity * 2 * size);
+    memcpy(grown, items, capacity * size);
+    return grown;
+}
+
+static void parser_free(OmegaParser* parser, void* memory) {
+    if (!parser->arena) free(memory);
+}
+
+static void parser_skip_whitespace(OmegaParser* parser) {
+    while (parser->cursor < parser->end &&
+           (*parser->cursor == ' ' || *parser->cursor == '\t' ||
+            *parser->cursor == '\n' || *parser->cursor == '\r')) {
+        parser->cursor++;
+    }
+}
+
+static bool parser_hex4(OmegaParser* parser, uint32_t* out) {
+    if (parser->end - parser->cursor < 4) return false;
+
+    uint32_t value = 0;
+    for (int i = 0; i < 4; i++) {
+        char c = *parser->cursor++;
+        value <<= 4;
+        if (c >= '0' && c <= '9') value |= c - '0';
+        else if (c >= 'a' && c <= 'f') value |= c - 'a' + 10;
+        else if (c >= 'A' && c <= 'F') value |= c - 'A' + 10;
+        else return false;
+    }
+    *out = value;
+    return true;
+}
+
+static void buffer_append_utf8(OmegaBuffer* buffer, uint32_t code_point) {
+    char bytes[4];
+    size_t length;
+
+    if (code_point < 0x80) {
+        bytes[0] = (char)code_point;
+        length = 1;
+    } else if (code_point < 0x800) {
+        bytes[0] = (char)(0xC0 | (code_point >> 6));
+        bytes[1] = (char)(0x80 | (code_point & 0x3F));
+        length = 2;
+    } else if (code_point < 0x10000) {
+        bytes[0] = (char)(0xE0 | (code_point >> 12));
+        bytes[1] = (char)(0x80 | ((code_point >> 6) & 0x3F));
+        bytes[2] = (char)(0x80 | (code_point & 0x3F));
+        length = 3;
+    } else {
+        bytes[0] = (char)(0xF0 | (code_point >> 18));
+        bytes[1] = (char)(0x80 | ((code_point >> 12) & 0x3F));
+        bytes[2] = (char)(0x80 | ((code_point >> 6) & 0x3F));
+        bytes[3] = (char)(0x80 | (code_point & 0x3F));
+        length = 4;
+    }
+    buffer_append(buffer, bytes, length);
+}
+
+// Decode the string literal at the cursor; returns a heap (or arena) copy
+// or NULL.
+static char* parser_string(OmegaParser* parser) {
+    if (parser->cursor >= parser->end || *parser->cursor != '"') return NULL;
+    parser->cursor++;
+
+    OmegaBuffer out = {0};
+    const char* run = parser->cursor;
+    if (parser->arena) {
+        out = parser->scratch;
+        out.length = 0;
+    }
+
+    while (parser->cursor < parser->end) {
+        unsigned char c = (unsigned char)*parser->cursor;
+
+        if (c == '"') {
+            buffer_append(&out, run, parser->cursor - run);
+            parser->cursor++;
+            if (!parser->arena) return out.data;
+
+            char* string = omega_arena_alloc(parser->arena, out.length + 1);
+            memcpy(string, out.data, out.length);
+            parser->scratch = out;
+            return string;
+        }
+        if (c < 0x20) break;
+        if (c != '\\') {
+            parser->cursor++;
+            continue;
+        }
+
+        buffer_append(&out, run, parser->cursor - run);
+        if (++parser->cursor >= parser->end) break;
+
+        char escape = *parser->cursor++;
+        switch (escape) {
+            case '"':  buffer_append(&out, "\"", 1); break;
+            case '\\': buffer_append(&out, "\\", 1); break;
+            case '/':  buffer_append(&out, "/", 1); break;
+            case 'b':  buffer_append(&out, "\b", 1); break;
+            case 'f':  buffer_append(&out, "\f", 1); break;
+            case 'n':  buffer_append(&out, "\n", 1); break;
+            case 'r':  buffer_append(&out, "\r", 1); break;
+            case 't':  buffer_append(&out, "\t", 1); break;
+            case 'u': {
+                uint32_t code_point, low;
+                // Strings are NUL-terminated, so U+0000 cannot be stored
+                if (!parser_hex4(parser, &code_point) || code_point == 0) goto fail;
+                // Surrogate pair → single code point; an unpaired
+                // surrogate has no UTF-8 encoding
+                if (code_point >= 0xDC00 && code_point < 0xE000) goto fail;
+                if (code_point >= 0xD800 && code_point < 0xDC00) {
+                    if (parser->end - parser->cursor < 6 ||
+                        parser->cursor[0] != '\\' || parser->cursor[1] != 'u') {
+                        goto fail;
+                    }
+                    parser->cursor += 2;
+                    if (!parser_hex4(parser, &low) || low < 0xDC00 || low >= 0xE000) goto fail;
+                    code_point = 0x10000 + ((code_point - 0xD800) << 10) + (low - 0xDC00);
+                }
+                buffer_append_utf8(&out, code_point);
+                break;
+            }
+            default:
+                goto fail;
+        }
+        run = parser->cursor;
+    }
+
+fail:
+    if (parser->arena) parser->scratch = out;
+    else free(out.data);
+    return NULL;
+}
+
+static bool parser_digits(OmegaParser* parser) {
+    const char* start = parser->cursor;
+    while (parser->cursor < parser->end && *parser->cursor >= '0' && *parser->cursor <= '9') {
+        parser->cursor++;
+    }
+    return parser->cursor > start;
+}
+
+// RFC 8259 grammar: -?(0|[1-9][0-9]*)(.[0-9]+)?([eE][+-]?[0-9]+)?
+// Values that overflow to ±inf are rejected rather than stored.
+static OmegaValue* parser_number(OmegaParser* parser) {
+    const char* start = parser->cursor;
+
+    if (parser->cursor < parser->end && *parser->cursor == '-') parser->cursor++;
+    if (parser->cursor < parser->end && *parser->cursor == '0') {
+        parser->cursor++;
+    } else if (parser->cursor >= parser->end || *parser->cursor < '1' || *parser->cursor > '9' ||
+               !parser_digits(parser)) {
+        return NULL;
+    }
+    if (parser->cursor < parser->end && *parser->cursor == '.') {
+        parser->cursor++;
+        if (!parser_digits(parser)) return NULL;
+    }
+    if (parser->cursor < parser->end && (*parser->cursor == 'e' || *parser->cursor == 'E')) {
+        parser->cursor++;
+        if (parser->cursor < parser->end && (*parser->cursor == '+' || *parser->cursor == '-')) {
+            parser->cursor++;
+        }
+        if (!parser_digits(parser)) return NULL;
+    }
+
+    // The input is not NUL-terminated, so strtod works on a copy
+    size_t length = parser->cursor - start;
+    char local[64];
+    char* text = length < sizeof(local) ? local : malloc(length + 1);
+    if (text != local) OMEGA_PROFILE_ALLOC(length + 1);
+    memcpy(text, start, length);
+    text[length] = '\0';
+
+    char* end;
+    double value = strtod(text, &end);
+    bool valid = end == text + length && isfinite(value);
+    if (text != local) free(text);
+
+    if (!valid) return NULL;
+    OmegaValue* omega = parser_create(parser, OMEGA_NUMBER);
+    omega->data.number = value;
+    return omega;
+}
+
+static bool parser_literal(OmegaParser* parser, const char* literal, size_t length) {
+    if ((size_t)(parser->end - parser->cursor) < length ||
+        memcmp(parser->cursor, literal, length) != 0) {
+        return false;
+    }
+    parser->cursor += length;
+    return true;
+}
+
+// Parser-side encapsulation: no per-insert metric recomputation, the
+// container is refreshed once when it closes.
+static void parser_array_push(OmegaParser* parser, OmegaValue* array, OmegaValue* value) {
+    if (array->data.array.count >= array->data.array.capacity) {
+        array->data.array.elements = parser_grow(parser, array->data.array.elements,
+                                                 array->data.array.capacity,
+                                                 sizeof(OmegaValue*));
+        array->data.array.capacity *= 2;
+    }
+    array->data.array.elements[array->data.array.count++] = value;
+    value->parent = array;
+}
+
+// Takes ownership of key; a repeated key replaces the earlier value.
+static void parser_object_put(OmegaParser* parser, OmegaValue* object, char* key,
+                              OmegaValue* value) {
+    OmegaObject* obj = object->data.object;
+    uint32_t key_hash = hash_string(key);
+    value->parent = object;
+
+    for (size_t i = 0; i < obj->count; i++) {
+        if (obj->entries[i].key_hash == key_hash && strcmp(obj->entries[i].key, key) == 0) {
+            OMEGA_PROFILE_KEY_SCAN(i + 1);
+            if (!parser->arena) omega_destroy(obj->entries[i].value);
+            obj->entries[i].value = value;
+            parser_free(parser, key);
+            return;
+        }
+    }
+
+    OMEGA_PROFILE_KEY_SCAN(obj->count);
+
+    if (obj->count >= obj->capacity) {
+        obj->entries = parser_grow(parser, obj->entries, obj->capacity, sizeof(OmegaEntry));
+        obj->capacity *= 2;
+    }
+
+    OmegaEntry* entry = &obj->entries[obj->count++];
+    entry->key = key;
+    entry->key_hash = key_hash;
+    entry->value = value;
+}
+
+static OmegaValue* parser_value(OmegaParser* parser, uint32_t depth) {
+    parser_skip_whitespace(parser);
+    if (parser->cursor >= parser->end || depth > OMEGA_MAX_DEPTH) return NULL;
+
+    OmegaValue* omega = NULL;
+
+    switch (*parser->cursor) {
+        case '{': {
+            omega = parser_create(parser, OMEGA_OBJECT);
+            parser->cursor++;
+            parser_skip_whitespace(parser);
+            if (parser->cursor < parser->end && *parser->cursor == '}') {
+                parser->cursor++;
+                break;
+            }
+            for (;;) {
+                parser_skip_whitespace(parser);
+                char* key = parser_string(parser);
+                if (!key) goto fail;
+                parser_skip_whitespace(parser);
+                if (parser->cursor >= parser->end || *parser->cursor != ':') {
+                    parser_free(parser, key);
+                    goto fail;
+                }
+                parser->cursor++;
+                OmegaValue* value = parser_value(parser, depth + 1);
+                if (!value) {
+                    parser_free(parser, key);
+                    goto fail;
+                }
+                parser_object_put(parser, omega, key, value);
+
+                parser_skip_whitespace(parser);
+                if (parser->cursor >= parser->end) goto fail;
+                if (*parser->cursor == ',') {
+                    parser->cursor++;
+                    continue;
+                }
+                if (*parser->cursor != '}') goto fail;
+                parser->cursor++;
+                break;
+            }
+            break;
+        }
+        case '[': {
+            omega = parser_create(parser, OMEGA_ARRAY);
+            parser->cursor++;
+            parser_skip_whitespace(parser);
+            if (parser->cursor < parser->end && *parser->cursor == ']') {
+                parser->cursor++;
+                break;
+            }
+            for (;;) {
+                OmegaValue* value = parser_value(parser, depth + 1);
+                if (!value) goto fail;
+                parser_array_push(parser, omega, value);
+
+                parser_skip_whitespace(parser);
+                if (parser->cursor >= parser->end) goto fail;
+                if (*parser->cursor == ',') {
+                    parser->cursor++;
+                    continue;
+                }
+                if (*parser->cursor != ']') goto fail;
+                parser->cursor++;
+                break;
+            }
+            break;
+        }
+        case '"': {
+            char* string = parser_string(parser);
+            if (!string) return NULL;
+            omega = parser_create(parser, OMEGA_STRING);
+            omega->data.string = string;
+            break;
+        }
+        case 't':
+            if (!parser_literal(parser, "true", 4)) return NULL;
+            omega = parser_create(parser, OMEGA_BOOL);
+            omega->data.boolean = true;
+            break;
+        case 'f':
+            if (!parser_literal(parser, "false", 5)) return NULL;
+            omega = parser_create(parser, OMEGA_BOOL);
+            break;
+        case 'n':
+            if (!parser_literal(parser, "null", 4)) return NULL;
+            omega = parser_create(parser, OMEGA_NULL);
+            break;
+        default:
+            omega = parser_number(parser);
+            if (!omega) return NULL;
+            break;
+    }
+
+    omega->recursion_depth = depth;
+    if (omega->type == OMEGA_ARRAY || omega->type == OMEGA_OBJECT) {
+        omega->is_canonical = false;
+    }
+    omega_refresh_metrics(omega);
+    return omega;
+
+fail:
+    if (!parser->arena) omega_destroy(omega);
+    return NULL;
+}
+
+// Parse one complete JSON text. Returns NULL if the input is malformed.
+static OmegaValue* omega_parse(const char* text, size_t length) {
+    OMEGA_PROFILE_SCOPE(OMEGA_ENTRY_PARSE);
+    OmegaParser parser = { .cursor = text, .end = text + length };
+    OmegaValue* omega = parser_value(&parser, 0);
+
+    parser_skip_whitespace(&parser);
+    if (omega && parser.cursor != parser.end) {
+        omega_destroy(omega);
+        return NULL;
+    }
+    return omega;
+}
+
+// As omega_parse, but the tree lives in arena until its next reset.
+// scratch is a reusable decoding buffer owned by the caller.
+static OmegaValue* omega_parse_arena(const char* text, size_t length, OmegaArena* arena,
+                                     OmegaBuffer* scratch) {
+    OMEGA_PROFILE_SCOPE(OMEGA_ENTRY_PARSE);
+    OmegaParser parser = { text, text + length, arena, *scratch };
+    OmegaValue* omega = parser_value(&parser, 0);
+
+    parser_skip_whitespace(&parser);
+    *scratch = parser.scratch;
+    return parser.cursor == parser.end ? omega : NULL;
+}
+
+// ============================================================================
+// JSON POINTER ADDRESSING (RFC 6901 paths into Ω)
+// ============================================================================
+
+// Decode the next "/token" of a pointer (~0 → ~, ~1 → /) and advance past
+// it. Returns NULL at the end of the pointer or if it is malformed.
+static char* pointer_next_token(const char** pointer) {
+    if (**pointer != '/') return NULL;
+
+    const char* start = ++*pointer;
+    const char* end = strchr(start, '/');
+    if (!end) end = start + strlen(start);
+
+    char* token = malloc(end - start + 1);
+    OMEGA_PROFILE_ALLOC(end - start + 1);
+    size_t length = 0;
+    for (const char* p = start; p < end; p++) {
+        if (*p == '~' && p + 1 < end && (p[1] == '0' || p[1] == '1')) {
+            token[length++] = p[1] == '0' ? '~' : '/';
+            p++;
+        } else {
+            token[length++] = *p;
+        }
+    }
+    token[length] = '\0';
+
+    *pointer = end;
+    return token;
+}
+
+static bool pointer_index(const char* token, size_t* index) {
+    if (!*token || (token[0] == '0' && token[1])) return false;
+
+    size_t value = 0;
+    for (const char* p = token; *p; p++) {
+        if (*p < '0' || *p > '9') return false;
+        value = value * 10 + (*p - '0');
+    }
+    *index = value;
+    return true;
+}
+
+static OmegaValue* omega_pointer_get(OmegaValue* omega, const char* pointer) {
+    OMEGA_PROFILE_SCOPE(OMEGA_ENTRY_POINTER_GET);
+    while (omega && *pointer) {
+        char* token = pointer_next_token(&pointer);
+        if (!token) return NULL;
+
+        size_t index;
+        if (omega->type == OMEGA_OBJECT) {
+            omega = omega_object_get(omega, token);
+        } else if (omega->type == OMEGA_ARRAY && pointer_index(token, &index) &&
+                   index < omega->data.array.count) {
+            omega = omega->data.array.elements[index];
+        } else {
+            omega = NULL;
+        }
+        free(token);
+    }
+    return omega;
+}
+
+// ============================================================================
+// LAZY DOCUMENTS (parse-on-touch)
+// ============================================================================
+
+/*
+ * A lazy document indexes only the structural characters of its text
+ * ({ } [ ] : , outside strings) and the pairing of brackets. Navigation
+ * hops over whole subtrees through that index; an OmegaValue subtree and
+ * its L(ω), H(Ω) and symmetry hash are built only for the path that is
+ * requested, and cached by text offset for later lookups. The text is
+ * borrowed and must outlive the document.
+ */
+
+typedef struct {
+    uint32_t offset;    // Text offset + 1, 0 marks an empty slot
+    OmegaValue* value;
+} OmegaLazySlot;
+
+typedef struct {
+    uint64_t hash;
+    char* pointer;      // NULL marks an empty slot
+    OmegaValue* value;  // Borrowed from an OmegaLazySlot
+} OmegaLazyPath;
+
+typedef struct {
+    const char* text;
+    size_t length;
+    uint32_t* structurals;   // Offsets of structural characters
+    uint32_t* matches;       // Index of the partner bracket, per structural
+    size_t count;
+    OmegaLazySlot* slots;    // Materialized subtrees
+    size_t slot_capacity;
+    size_t slot_count;
+    OmegaLazyPath* paths;    // Resolved pointers
+    size_t path_capacity;
+    size_t path_count;
+    size_t bytes_materialized;
+} OmegaLazyDocument;
+
+static void lazy_push_structural(OmegaLazyDocument* doc, size_t* capacity, size_t offset) {
+    if (doc->count >= *capacity) {
+        OMEGA_PROFILE_REALLOC(*capacity * sizeof(uint32_t));
+        OMEGA_PROFILE_REALLOC(*capacity * sizeof(uint32_t));
+        *capacity *= 2;
+        doc->structurals = realloc(doc->structurals, *capacity * sizeof(uint32_t));
+        doc->matches = realloc(doc->matches, *capacity * sizeof(uint32_t));
+    }
+    doc->structurals[doc->count] = (uint32_t)offset;
+    doc->matches[doc->count] = 0;
+    doc->count++;
+}
+
+static void omega_lazy_close(OmegaLazyDocument* doc) {
+    if (!doc) return;
+
+    for (size_t i = 0; i < doc->slot_capacity; i++) {
+        if (doc->slots[i].offset) omega_destroy(doc->slots[i].value);
+    }
+    for (size_t i = 0; i < doc->path_capacity; i++) {
+        free(doc->paths[i].pointer);
+    }
+    free(doc->slots);
+    free(doc->paths);
+    free(doc->structurals);
+    free(doc->matches);
+    free(doc);
+}
+
+// Build the structural index. Returns NULL on unbalanced brackets or an
+// unterminated string; everything else is validated on materialization.
+static OmegaLazyDocument* omega_lazy_open(const char* text, size_t length) {
+    OMEGA_PROFILE_SCOPE(OMEGA_ENTRY_LAZY_OPEN);
+    if (length >= UINT32_MAX) return NULL;
+
+    OmegaLazyDocument* doc = calloc(1, sizeof(OmegaLazyDocument));
+    OMEGA_PROFILE_ALLOC(sizeof(OmegaLazyDocument));
+    doc->text = text;
+    doc->length = length;
+
+    size_t capacity = 64 + length / 8;
+    doc->structurals = malloc(capacity * sizeof(uint32_t));
+    doc->matches = malloc(capacity * sizeof(uint32_t));
+    OMEGA_PROFILE_ALLOC(capacity * sizeof(uint32_t));
+    OMEGA_PROFILE_ALLOC(capacity * sizeof(uint32_t));
+
+    size_t stack_capacity = 64, depth = 0;
+    uint32_t* stack = malloc(stack_capacity * sizeof(uint32_t));
+    OMEGA_PROFILE_ALLOC(stack_capacity * sizeof(uint32_t));
+
+    for (size_t i = 0; i < length; i++) {
+        switch (text[i]) {
+            case '"': {
+                // The closing quote is the first one not escaped by an odd
+                // run of backslashes
+                const char* body = text + i + 1;
+                const char* p = body;
+                for (;;) {
+                    p = memchr(p, '"', text + length - p);
+                    if (!p) goto fail;
+                    const char* run = p;
+                    while (run > body && run[-1] == '\\') run--;
+                    if ((p - run) % 2 == 0) break;
+                    p++;
+                }
+                i = p - text;
+                break;
+            }
+            case '{':
+            case '[':
+                if (depth >= stack_capacity) {
+                    OMEGA_PROFILE_REALLOC(stack_capacity * sizeof(uint32_t));
+                    stack_capacity *= 2;
+                    stack = realloc(stack, stack_capacity * sizeof(uint32_t));
+                }
+                stack[depth++] = (uint32_t)doc->count;
+                lazy_push_structural(doc, &capacity, i);
+                break;
+            case '}':
+            case ']': {
+                char open = text[i] == '}' ? '{' : '[';
+                if (depth == 0 || text[doc->structurals[stack[depth - 1]]] != open) goto fail;
+                uint32_t partner = stack[--depth];
+                doc->matches[partner] = (uint32_t)doc->count;
+                lazy_push_structural(doc, &capacity, i);
+                doc->matches[doc->count - 1] = partner;
+                break;
+            }
+            case ':':
+            case ',':
+                lazy_push_structural(doc, &capacity, i);
+                break;
+            default:
+                break;
+        }
+    }
+    if (depth != 0) goto fail;
+
+    free(stack);
+    doc->slot_capacity = 16;
+    doc->slots = calloc(doc->slot_capacity, sizeof(OmegaLazySlot));
+    doc->path_capacity = 16;
+    doc->paths = calloc(doc->path_capacity, sizeof(OmegaLazyPath));
+    OMEGA_PROFILE_ALLOC(doc->slot_capacity * sizeof(OmegaLazySlot));
+    OMEGA_PROFILE_ALLOC(doc->path_capacity * sizeof(OmegaLazyPath));
+    return doc;
+
+fail:
+    free(stack);
+    omega_lazy_close(doc);
+    return NULL;
+}
+
+static size_t lazy_skip_whitespace(const OmegaLazyDocument* doc, size_t offset) {
+    while (offset < doc->length &&
+           (doc->text[offset] == ' ' || doc->text[offset] == '\t' ||
+            doc->text[offset] == '\n' || doc->text[offset] == '\r')) {
+        offset++;
+    }
+    return offset;
+}
+
+static bool lazy_is_container(const OmegaLazyDocument* doc, size_t offset) {
+    return offset < doc->length && (doc->text[offset] == '{' || doc->text[offset] == '[');
+}
+
+static bool lazy_is_structural(const OmegaLazyDocument* doc, size_t index, char c) {
+    return index < doc->count && doc->text[doc->structurals[index]] == c;
+}
+
+// Compare the key literal in text[from, to) with an already decoded key.
+static bool lazy_key_equals(const OmegaLazyDocument* doc, size_t from, size_t to,
+                            const char* key) {
+    from = lazy_skip_whitespace(doc, from);
+    if (from >= to || doc->text[from] != '"') return false;
+
+    const char* raw = doc->text + from + 1;
+    const char* close = memchr(raw, '"', to - from - 1);
+    if (close && !memchr(raw, '\\', close - raw)) {
+        size_t length = close - raw;
+        return strlen(key) == length && memcmp(raw, key, length) == 0;
+    }
+
+    OmegaParser parser = { .cursor = doc->text + from, .end = doc->text + to };
+    char* decoded = parser_string(&parser);
+    bool equal = decoded && strcmp(decoded, key) == 0;
+    free(decoded);
+    return equal;
+}
+
+// Step from the container at (*offset, *index) to the child named by token.
+// A value is addressed by its text offset and the index of the first
+// structural character at or after it.
+static bool lazy_child(const OmegaLazyDocument* doc, size_t* offset, size_t* index,
+                       const char* token) {
+    char open = doc->text[*offset];
+    size_t wanted = 0;
+
+    if (open != '{' && open != '[') return false;
+    if (open == '[' && !pointer_index(token, &wanted)) return false;
+    size_t first = lazy_skip_whitespace(doc, doc->structurals[*index] + 1);
+    if (first == doc->structurals[doc->matches[*index]]) return false;  // Empty container
+
+    // A repeated key resolves to its last occurrence, as in omega_parse
+    bool found = false;
+    size_t separator = *index;
+    for (size_t position = 0;; position++) {
+        size_t value_index = separator + 1;
+        bool match;
+
+        if (open == '{') {
+            if (!lazy_is_structural(doc, value_index, ':')) return false;
+            match = lazy_key_equals(doc, doc->structurals[separator] + 1,
+                                    doc->structurals[value_index], token);
+            value_index++;
+        } else {
+            match = position == wanted;
+        }
+
+        size_t value_offset = lazy_skip_whitespace(doc, doc->structurals[value_index - 1] + 1);
+        if (match) {
+            *offset = value_offset;
+            *index = value_index;
+            found = true;
+            if (open == '[') return true;
+        }
+
+        separator = lazy_is_container(doc, value_offset)
+            ? doc->matches[value_index] + 1 : value_index;
+        if (!lazy_is_structural(doc, separator, ',')) return found;
+    }
+}
+
+static OmegaLazySlot* lazy_slot(OmegaLazyDocument* doc, size_t offset) {
+    size_t mask = doc->slot_capacity - 1;
+    size_t slot = (offset * 2654435761U) & mask;
+
+    while (doc->slots[slot].offset && doc->slots[slot].offset != offset + 1) {
+        slot = (slot + 1) & mask;
+    }
+    return &doc->slots[slot];
+}
+
+static void lazy_cache_insert(OmegaLazyDocument* doc, size_t offset, OmegaValue* value) {
+    if ((doc->slot_count + 1) * 2 > doc->slot_capacity) {
+        OmegaLazySlot* old = doc->slots;
+        size_t old_capacity = doc->slot_capacity;
+
+        doc->slot_capacity *= 2;
+        doc->slots = calloc(doc->slot_capacity, sizeof(OmegaLazySlot));
+        OMEGA_PROFILE_ALLOC(doc->slot_capacity * sizeof(OmegaLazySlot));
+        for (size_t i = 0; i < old_capacity; i++) {
+            if (old[i].offset) *lazy_slot(doc, old[i].offset - 1) = old[i];
+        }
+        free(old);
+    }
+
+    OmegaLazySlot* slot = lazy_slot(doc, offset);
+    slot->offset = (uint32_t)offset + 1;
+    slot->value = value;
+    doc->slot_count++;
+}
+
+static OmegaLazyPath* lazy_path(OmegaLazyDocument* doc, const char* pointer, uint64_t hash) {
+    size_t mask = doc->path_capacity - 1;
+    size_t slot = hash & mask;
+
+    while (doc->paths[slot].pointer &&
+           (doc->paths[slot].hash != hash || strcmp(doc->paths[slot].pointer, pointer) != 0)) {
+        slot = (slot + 1) & mask;
+    }
+    return &doc->paths[slot];
+}
+
+static void lazy_path_insert(OmegaLazyDocument* doc, const char* pointer, uint64_t hash,
+                             OmegaValue* value) {
+    if ((doc->path_count + 1) * 2 > doc->path_capacity) {
+        OmegaLazyPath* old = doc->paths;
+        size_t old_capacity = doc->path_capacity;
+
+        doc->path_capacity *= 2;
+        doc->paths = calloc(doc->path_capacity, sizeof(OmegaLazyPath));
+        OMEGA_PROFILE_ALLOC(doc->path_capacity * sizeof(OmegaLazyPath));
+        for (size_t i = 0; i < old_capacity; i++) {
+            if (old[i].pointer) *lazy_path(doc, old[i].pointer, old[i].hash) = old[i];
+        }
+        free(old);
+    }
+
+    OmegaLazyPath* path = lazy_path(doc, pointer, hash);
+    path->hash = hash;
+    path->pointer = strdup(pointer);
+    OMEGA_PROFILE_ALLOC(strlen(pointer) + 1);
+    path->value = value;
+    doc->path_count++;
+}
+
+// Walk the structural index until the path enters an already materialized
+// subtree or ends; only then is the remaining text parsed.
+static OmegaValue* lazy_resolve(OmegaLazyDocument* doc, const char* pointer) {
+    size_t offset = lazy_skip_whitespace(doc, 0);
+    size_t index = 0;
+    uint32_t depth = 0;
+
+    if (offset >= doc->length) return NULL;
+
+    for (;;) {
+        OmegaLazySlot* slot = lazy_slot(doc, offset);
+        if (slot->offset) return omega_pointer_get(slot->value, pointer);
+        if (!*pointer) break;
+
+        char* token = pointer_next_token(&pointer);
+        if (!token) return NULL;
+        bool found = lazy_child(doc, &offset, &index, token);
+        free(token);
+        if (!found) return NULL;
+        depth++;
+    }
+
+    OmegaParser parser = { .cursor = doc->text + offset, .end = doc->text + doc->length };
+    OmegaValue* omega = parser_value(&parser, depth);
+    if (!omega) return NULL;
+
+    doc->bytes_materialized += parser.cursor - (doc->text + offset);
+    lazy_cache_insert(doc, offset, omega);
+    return omega;
+}
+
+// Resolve a JSON pointer ("" is the root, "/a/0/b" a nested field) and
+// return the materialized subtree, owned by the document. Returns NULL if
+// the path does not exist or the addressed text is malformed.
+static OmegaValue* omega_lazy_get(OmegaLazyDocument* doc, const char* pointer) {
+    OMEGA_PROFILE_SCOPE(OMEGA_ENTRY_LAZY_GET);
+    uint64_t hash = canon_hash_string(pointer);
+    OmegaLazyPath* path = lazy_path(doc, pointer, hash);
+    if (path->pointer) return path->value;
+
+    OmegaValue* omega = lazy_resolve(doc, pointer);
+    if (omega) lazy_path_insert(doc, pointer, hash, omega);
+    return omega;
+}
+
+// ============================================================================
+// PROFILE REPORT (instrumentation → Ω)
+// ============================================================================
+
+#ifdef OMEGA_PROFILE
+
+static const char* const omega_type_names[OMEGA_TYPE_COUNT] = {
+    "null", "bool", "number", "string", "array", "object", "reference"
+};
+
+#ifdef OMEGA_PROFILE_TIMERS
+static const char* const omega_entry_names[OMEGA_ENTRY_COUNT] = {
+    "omega_create", "omega_array_append", "omega_object_set", "omega_object_get",
+    "omega_serialize", "omega_serialize_compact", "omega_serialize_canonical",
+    "omega_destroy", "omega_canonicalize", "omega_parse", "omega_pointer_get",
+    "omega_lazy_open", "omega_lazy_get"
+};
+#endif
+
+// Sum the counters of every thread that has touched omegajson so far.
+static size_t omega_profile_snapshot(OmegaProfileCounters* total) {
+    size_t threads = 0;
+    memset(total, 0, sizeof(*total));
+
+    for (OmegaProfileCounters* c = atomic_load(&omega_profile_threads); c; c = c->next) {
+        _Atomic uint64_t* from = (_Atomic uint64_t*)c;
+        _Atomic uint64_t* to = (_Atomic uint64_t*)total;
+        size_t fields = offsetof(OmegaProfileCounters, entry_depth) / sizeof(uint64_t);
+
+        for (size_t i = 0; i < fields; i++) {
+            uint64_t value = atomic_load_explicit(&from[i], memory_order_relaxed);
+            if (&from[i] == &c->key_probe_max) {
+                if (value > total->key_probe_max) total->key_probe_max = value;
+            } else {
+                to[i] += value;
+            }
+        }
+        threads++;
+    }
+    return threads;
+}
+
+// Zero all counters. Counts racing with other threads may survive.
+static void omega_profile_reset(void) {
+    for (OmegaProfileCounters* c = atomic_load(&omega_profile_threads); c; c = c->next) {
+        _Atomic uint64_t* field = (_Atomic uint64_t*)c;
+        size_t fields = offsetof(OmegaProfileCounters, entry_depth) / sizeof(uint64_t);
+        for (size_t i = 0; i < fields; i++) {
+            atomic_store_explicit(&field[i], 0, memory_order_relaxed);
+        }
+    }
+}
+
+static void profile_set_count(OmegaValue* object, const char* key, uint64_t value) {
+    omega_object_set(object, key, omega_create_number((double)value));
+}
+
+// Write the aggregated counters as JSON through omega_serialize. The
+// snapshot is taken first, so building the report does not skew it.
+static void omega_profile_dump(FILE* out) {
+    OmegaProfileCounters total;
+    size_t threads = omega_profile_snapshot(&total);
+
+    OmegaValue* report = omega_create_object();
+    profile_set_count(report, "threads", threads);
+
+    OmegaValue* created = omega_create_object();
+    OmegaValue* destroyed = omega_create_object();
+    uint64_t live = 0;
+    for (int t = 0; t < OMEGA_TYPE_COUNT; t++) {
+        profile_set_count(created, omega_type_names[t], total.nodes_created[t]);
+        profile_set_count(destroyed, omega_type_names[t], total.nodes_destroyed[t]);
+        live += total.nodes_created[t] - total.nodes_destroyed[t];
+    }
+    OmegaValue* nodes = omega_create_object();
+    omega_object_set(nodes, "created", created);
+    omega_object_set(nodes, "destroyed", destroyed);
+    profile_set_count(nodes, "live", live);
+    omega_object_set(report, "nodes", nodes);
+
+    OmegaValue* memory = omega_create_object();
+    profile_set_count(memory, "allocations", total.allocations);
+    profile_set_count(memory, "bytes_allocated", total.bytes_allocated);
+    profile_set_count(memory, "realloc_events", total.realloc_events);
+    omega_object_set(report, "memory", memory);
+
+    OmegaValue* metrics = omega_create_object();
+    profile_set_count(metrics, "recomputations", total.metric_recomputations);
+    profile_set_count(metrics, "refreshes", total.metric_refreshes);
+    profile_set_count(metrics, "nodes_visited", total.metric_nodes_visited);
+    omega_object_set(report, "metrics", metrics);
+
+    OmegaValue* keys = omega_create_object();
+    OmegaValue* histogram = omega_create_array();
+    profile_set_count(keys, "scans", total.key_scans);
+    profile_set_count(keys, "probes", total.key_probes);
+    profile_set_count(keys, "max_probe", total.key_probe_max);
+    omega_object_set(keys, "mean_probe", omega_create_number(
+        total.key_scans ? (double)total.key_probes / total.key_scans : 0.0));
+    for (int b = 0; b < OMEGA_PROBE_BUCKETS; b++) {
+        omega_array_append(histogram, omega_create_number((double)total.key_probe_histogram[b]));
+    }
+    omega_object_set(keys, "log2_histogram", histogram);
+    omega_object_set(report, "key_scans", keys);
+
+#ifdef OMEGA_PROFILE_TIMERS
+    OmegaValue* entries = omega_create_object();
+    for (int e = 0; e < OMEGA_ENTRY_COUNT; e++) {
+        if (!total.entry_calls[e]) continue;
+        OmegaValue* entry = omega_create_object();
+        profile_set_count(entry, "calls", total.entry_calls[e]);
+        profile_set_count(entry, "ticks", total.entry_ticks[e]);
+        omega_object_set(entry, "ticks_per_call", omega_create_number(
+            (double)total.entry_ticks[e] / total.entry_calls[e]));
+        omega_object_set(entries, omega_entry_names[e], entry);
+    }
+#if defined(__x86_64__) || defined(__i386__)
+    omega_object_set(report, "tick_unit", omega_create_string("tsc_cycles"));
+#else
+    omega_object_set(report, "tick_unit", omega_create_string("ns"));
+#endif
+    omega_object_set(report, "entry_points", entries);
+#endif
+
+    omega_serialize(report, out);
+    omega_destroy(report);
+}
+
+#endif
+
+// ============================================================================
+// DEMONSTRATION & TEST
+// ============================================================================
+
+#ifndef OMEGAJSON_NO_MAIN
+int main(void) {
+    printf("=== OmegaJSON: Reflectological Data Format ===\n\n");
+    
+    // Ω₀ = ∅ (null configuration)
+    printf("Stage 1 - Ω₀ (empty configuration):\n");
+    OmegaValue* omega0 = omega_create();
+    omega_serialize(omega0, stdout);
+    printf("Complexity L(ω₀) = %.2f\n", omega0->complexity);
+    printf("Entropy H(ω₀) = %u\n\n", omega0->entropy);
+    
+    // Ω₁ = {∅} (singleton encapsulation)
+    printf("Stage 2 - Ω₁ (primitive structures):\n");
+    OmegaValue* omega1 = omega_create_object();
+    omega_object_set(omega1, "empty", omega0);
+    omega_object_set(omega1, "truth", omega_create_bool(true));
+    omega_object_set(omega1, "number", omega_create_number(42.0));
+    omega_object_set(omega1, "string", omega_create_string("Omega"));
+    omega_serialize(omega1, stdout);
+    printf("Complexity L(ω₁) = %.2f\n", omega1->complexity);
+    printf("Entropy H(ω₁) = %u\n", omega1->entropy);
+    printf("Symmetry Hash: 0x%08X\n\n", omega1->symmetry_hash);
+    
+    // Ω₂ (recursive encapsulation)
+    printf("Stage 3 - Ω₂ (recursive structures):\n");
+    OmegaValue* omega2 = omega_create_object();
+    
+    OmegaValue* nested_array = omega_create_array();
+    omega_array_append(nested_array, omega_create_number(1.0));
+    omega_array_append(nested_array, omega_create_number(2.0));
+    omega_array_append(nested_array, omega_create_number(3.0));
+    
+    OmegaValue* nested_object = omega_create_object();
+    omega_object_set(nested_object, "reflective", omega_create_bool(true));
+    omega_object_set(nested_object, "convergence", omega_create_string("stable"));
+    
+    omega_object_set(omega2, "array", nested_array);
+    omega_object_set(omega2, "nested", nested_object);
+    omega_object_set(omega2, "previous", omega1);
+    
+    omega_serialize(omega2, stdout);
+    printf("Complexity L(ω₂) = %.2f\n", omega2->complexity);
+    printf("Entropy H(ω₂) = %u\n", omega2->entropy);
+    printf("Recursion Depth: %u\n\n", omega2->recursion_depth);
+    
+    // Demonstrate symmetry detection
+    printf("Stage 4 - Symmetry Analysis (Ω/G):\n");
+    OmegaValue* sym1 = omega_create_array();
+    omega_array_append(sym1, omega_create_number(1.0));
+    omega_array_append(sym1, omega_create_number(2.0));
+    
+    OmegaValue* sym2 = omega_create_array();
+    omega_array_append(sym2, omega_create_number(1.0));
+    omega_array_append(sym2, omega_create_number(2.0));
+    
+    printf("Array 1 hash: 0x%08X\n", sym1->symmetry_hash);
+    printf("Array 2 hash: 0x%08X\n", sym2->symmetry_hash);
+    printf("Symmetric: %s\n\n", 
+           sym1->symmetry_hash == sym2->symmetry_hash ? "YES (Ω/~)" : "NO");
+    
+    // Canonical representative ω* (Ω/~ and Ω/G)
+    printf("Stage 5 - Canonical Form (ω* = argmin L(ω)):\n");
+    OmegaCanonCache* cache = omega_canon_cache_create();
+    
+    OmegaValue* doc1 = omega_create_object();
+    omega_object_set(doc1, "zeta", omega_create_number(-0.0));
+    omega_object_set(doc1, "alpha", omega_create_string("line\nbreak"));
+    omega_object_set(doc1, "list", omega_create_array());
+    omega_object_set(doc1, "meta", omega_create_object());
+    omega_object_set(doc1->data.object->entries[3].value, "version", omega_create_number(1.0));
+    
+    OmegaValue* doc2 = omega_create_object();
+    omega_object_set(doc2, "list", omega_create_array());
+    omega_object_set(doc2, "alpha", omega_create_string("line\nbreak"));
+    omega_object_set(doc2, "zeta", omega_create_number(0.0));
+    OmegaValue* meta = omega_create_object();
+    omega_object_set(meta, "version", omega_create_number(1.0));
+    omega_object_set(doc2, "meta", meta);
+    
+    size_t len1, len2;
+    char* bytes1 = omega_serialize_canonical(doc1, cache, &len1);
+    char* bytes2 = omega_serialize_canonical(doc2, cache, &len2);
+    printf("Document 1: %s\n", bytes1);
+    printf("Document 2: %s\n", bytes2);
+    printf("Byte-identical: %s\n",
+           len1 == len2 && memcmp(bytes1, bytes2, len1) == 0 ? "YES (ω₁* = ω₂*)" : "NO");
+    
+    // Only the touched subtree is rebuilt on the next pass
+    omega_array_append(doc1->data.object->entries[1].value, omega_create_bool(true));
+    size_t memo_before = cache->memo_hits;
+    char* bytes3 = omega_serialize_canonical(doc1, cache, NULL);
+    printf("After append: %s\n", bytes3);
+    printf("Memoized subtrees reused: %zu, interned classes: %zu\n\n",
+           cache->memo_hits - memo_before, cache->count);
+    
+    free(bytes1);
+    free(bytes2);
+    free(bytes3);
+    omega_destroy(doc1);
+    omega_destroy(doc2);
+    omega_canon_cache_destroy(cache);
+    
+    // Parse-on-touch: only the addressed subtree becomes an Ω-structure
+    printf("Stage 6 - Lazy Materialization (parse-on-touch):\n");
+    const char* text =
+        "{\"meta\": {\"id\": 7, \"tags\": [\"x\", \"y\"]},"
+        " \"payload\": [1, 2, 3, {\"deep\": \"skipped\"}]}";
+    OmegaLazyDocument* lazy = omega_lazy_open(text, strlen(text));
+    printf("Structural positions indexed: %zu\n", lazy->count);
+    OmegaValue* tags = omega_lazy_get(lazy, "/meta/tags");
+    omega_serialize(tags, stdout);
+    printf("Complexity L = %.2f, Entropy H = %u\n", tags->complexity, tags->entropy);
+    printf("Bytes materialized: %zu of %zu\n", lazy->bytes_materialized, lazy->length);
+    OmegaValue* full = omega_parse(text, strlen(text));
+    OmegaBuffer compact = {0};
+    omega_serialize_compact(full, &compact);
+    printf("Compact: %s\n", compact.data);
+    free(compact.data);
+    printf("Matches full parse: %s\n",
+           omega_pointer_get(full, "/meta/tags")->symmetry_hash == tags->symmetry_hash
+               ? "YES" : "NO");
+    
+    // Same tree in an arena, released in one step
+    OmegaArena* arena = omega_arena_create(0);
+    OmegaBuffer scratch = {0};
+    OmegaValue* pooled = omega_parse_arena(text, strlen(text), arena, &scratch);
+    printf("Arena parse matches: %s\n\n",
+           pooled && pooled->symmetry_hash == full->symmetry_hash ? "YES" : "NO");
+    omega_arena_reset(arena);
+    omega_arena_destroy(arena);
+    free(scratch.data);
+    omega_destroy(full);
+    omega_lazy_close(lazy);
+    
+#ifdef OMEGA_PROFILE
+    // Incremental construction recomputes metrics over the whole subtree
+    printf("Stage 7 - Instrumentation (cost of Ω, 256 incremental sets):\n");
+    omega_profile_reset();
+    OmegaValue* wide = omega_create_object();
+    for (int i = 0; i < 256; i++) {
+        char key[16];
+        snprintf(key, sizeof(key), "k%d", i);
+        omega_object_set(wide, key, omega_create_number(i));
+    }
+    omega_destroy(wide);
+    omega_profile_dump(stdout);
+    printf("\n");
+#endif
     
     printf("=== Formalization Complete ===\n");
     printf("✓ Ω-structures defined\n");
@@ -506,6 +2522,7 @@ int main(void) {
     printf("✓ Symmetry reduction (Ω/G) operational\n");
     printf("✓ Loss function L(ω) calculated\n");
     printf("✓ Entropy management H(Ω) active\n");
+    printf("✓ Canonical form ω* memoized\n");
     printf("✓ Reflective convergence achieved\n");
     
     // Cleanup
@@ -515,3 +2532,4 @@ int main(void) {
     
     return 0;
 }
+#endif